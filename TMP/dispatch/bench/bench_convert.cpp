@@ -0,0 +1,61 @@
+/* Bulk conversions between float and Half/BFloat16: every kernel version
+ * the CPU supports, in ns/element and GB/s of float data.
+ *
+ * usage: bench_convert [elements]   (default 10^7)
+ */
+
+#include "../convert_kernels.H"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+template <typename F>
+double ns_per_element(std::size_t n, F&& f)
+{
+    f(); // warm up
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(n);
+}
+
+void report(const char* name, ConvertKernel kernel, double ns)
+{
+    std::cout << std::left << std::setw(20) << name << std::setw(10) << toString(kernel) << std::right
+              << std::fixed << std::setw(8) << std::setprecision(3) << ns << " ns/element"
+              << std::setw(8) << std::setprecision(1) << sizeof(float) / ns << " GB/s\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::vector<float> floats(n), back(n);
+    for (std::size_t i = 0; i < n; ++i) floats[i] = static_cast<float>(i % 1000) * 0.01f - 5.0f;
+    std::vector<Half> halves(n);
+    std::vector<BFloat16> bfloats(n);
+
+    for (ConvertKernel kernel : {ConvertKernel::Scalar, ConvertKernel::F16C, ConvertKernel::AVX512}) {
+        if (!convertKernelSupported(kernel)) continue;
+        auto pick = [kernel](auto scalar, auto f16c, auto avx512) {
+            return kernel == ConvertKernel::AVX512 ? avx512 : kernel == ConvertKernel::F16C ? f16c : scalar;
+        };
+        auto toHalf = pick(&floatToHalfScalar, &floatToHalfF16C, &floatToHalfAVX512);
+        auto fromHalf = pick(&halfToFloatScalar, &halfToFloatF16C, &halfToFloatAVX512);
+        auto toBFloat = pick(&floatToBFloat16Scalar, &floatToBFloat16F16C, &floatToBFloat16AVX512);
+        auto fromBFloat = pick(&bfloat16ToFloatScalar, &bfloat16ToFloatF16C, &bfloat16ToFloatAVX512);
+
+        report("float -> Half", kernel, ns_per_element(n, [&] { toHalf(floats.data(), halves.data(), n); }));
+        report("Half -> float", kernel, ns_per_element(n, [&] { fromHalf(halves.data(), back.data(), n); }));
+        report("float -> BFloat16", kernel, ns_per_element(n, [&] { toBFloat(floats.data(), bfloats.data(), n); }));
+        report("BFloat16 -> float", kernel, ns_per_element(n, [&] { fromBFloat(bfloats.data(), back.data(), n); }));
+        std::cout << "\n";
+    }
+}
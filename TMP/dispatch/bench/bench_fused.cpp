@@ -0,0 +1,67 @@
+/* r = a*x + b*y - z with a kernel per operation and as one fused expression,
+ * in ns/element and effective GB/s (the 3 reads and 1 write the expression
+ * needs at least, divided by the time taken).
+ *
+ * The separate kernels pass over r four times (fill, then 3 axpy), i.e. move
+ * ~10 elements per result element; the fused loop moves 4.
+ *
+ * usage: bench_fused [elements]   (default 10^7)
+ */
+
+#include "../tensor_expr.H"
+#include "../tensor_kernels.H"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+template <typename F>
+double ns_per_element(std::size_t n, F&& f)
+{
+    f(); // warm up
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(n);
+}
+
+void report(ScalarType type, const char* what, double ns)
+{
+    double gb_per_s = 4.0 * static_cast<double>(scalarTypeSize(type)) / ns;
+    std::cout << std::left << std::setw(10) << toString(type) << std::setw(12) << what << std::right
+              << std::fixed << std::setw(8) << std::setprecision(3) << ns << " ns/element"
+              << std::setw(8) << std::setprecision(2) << gb_per_s << " GB/s\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    auto extent = static_cast<std::int64_t>(n);
+    double a = 2, b = 3;
+    double checksum = 0;
+
+    for (ScalarType type : {ScalarType::Float, ScalarType::Double, ScalarType::Half,
+                            ScalarType::BFloat16, ScalarType::Int8, ScalarType::Int}) {
+        Tensor x(type, {extent}), y(type, {extent}), z(type, {extent}), r(type, {extent});
+        x.fill(1);
+        y.fill(2);
+        z.fill(3);
+
+        report(type, "separate", ns_per_element(n, [&] {
+            r.fill(0);
+            axpy(a, x, r);
+            axpy(b, y, r);
+            axpy(-1, z, r);
+        }));
+        checksum += sum(r);
+        report(type, "fused", ns_per_element(n, [&] { assign(r, a * x + b * y - z); }));
+        checksum += sum(r);
+        std::cout << "\n";
+    }
+    std::cout << "checksum: " << checksum << "\n";
+}
@@ -0,0 +1,74 @@
+/* Tensor kernels for every ScalarType and every ISA level the CPU supports,
+ * in ns/element: add, axpy, sum and dot with one dispatch per call, and sum
+ * with one DISPATCH_SCALAR_TYPE per element for comparison.
+ *
+ * usage: bench_tensor [elements]   (default 10^7)
+ */
+
+#include "../tensor_kernels.H"
+#include "../dispatch.H"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+template <typename F>
+double ns_per_element(std::size_t n, F&& f)
+{
+    f(); // warm up
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(n);
+}
+
+void report(ScalarType type, const char* isa, const char* what, double ns)
+{
+    std::cout << std::left << std::setw(10) << toString(type) << std::setw(8) << isa << std::setw(24) << what << std::right
+              << std::fixed << std::setw(8) << std::setprecision(3) << ns << " ns/element\n";
+}
+
+// the value at flat index i of a contiguous tensor, dispatched per call
+double element(Tensor const& t, std::size_t i)
+{
+    DISPATCH_SCALAR_TYPE(t.dtype(), [&]() {
+        return static_cast<double>(static_cast<scalar_t const*>(t.data())[i]);
+    });
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    auto extent = static_cast<std::int64_t>(n);
+    double checksum = 0;
+
+    for (std::size_t t = 0; t < numScalarTypes; ++t) {
+        auto type = static_cast<ScalarType>(t);
+        Tensor a(type, {extent}), b(type, {extent});
+        a.fill(1);
+        b.fill(2);
+
+        Tensor c(type, {extent});
+
+        for (CpuIsa isa : {CpuIsa::Scalar, CpuIsa::SSE42, CpuIsa::AVX2, CpuIsa::AVX512}) {
+            if (!cpuIsaSupported(isa)) continue;
+            TensorKernels const& kernels = tensorKernelTable(isa)[scalarTypeIndex(type)];
+            report(type, toString(isa), "add", ns_per_element(n, [&] { kernels.add(a, b, c); }));
+            report(type, toString(isa), "axpy", ns_per_element(n, [&] { kernels.axpy(1, a, b); }));
+            report(type, toString(isa), "sum", ns_per_element(n, [&] { checksum += kernels.sum(a); }));
+            report(type, toString(isa), "dot", ns_per_element(n, [&] { checksum += kernels.dot(a, b); }));
+        }
+        report(type, toString(cpuIsa()), "sum, dispatch/element", ns_per_element(n, [&] {
+            double total = 0;
+            for (std::size_t i = 0; i < n; ++i) total += element(a, i);
+            checksum += total;
+        }));
+        std::cout << "\n";
+    }
+    std::cout << "checksum: " << checksum << "\n";
+}
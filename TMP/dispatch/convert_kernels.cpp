@@ -0,0 +1,240 @@
+#include "convert_kernels.H"
+#include "dispatch.H"
+
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+
+namespace {
+
+std::uint16_t const* bits(Half const* h) { return reinterpret_cast<std::uint16_t const*>(h); }
+std::uint16_t* bits(Half* h) { return reinterpret_cast<std::uint16_t*>(h); }
+std::uint16_t const* bits(BFloat16 const* b) { return reinterpret_cast<std::uint16_t const*>(b); }
+std::uint16_t* bits(BFloat16* b) { return reinterpret_cast<std::uint16_t*>(b); }
+
+template <typename To, typename From>
+void convertLoop(void const* input, void* output, std::size_t n) {
+    From const* in = static_cast<From const*>(input);
+    To* out = static_cast<To*>(output);
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<To>(in[i]);
+    }
+}
+
+} // namespace
+
+void halfToFloatScalar(Half const* in, float* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = halfBitsToFloat(in[i].bits);
+}
+
+void floatToHalfScalar(float const* in, Half* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i].bits = floatToHalfBits(in[i]);
+}
+
+void bfloat16ToFloatScalar(BFloat16 const* in, float* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = bfloat16BitsToFloat(in[i].bits);
+}
+
+void floatToBFloat16Scalar(float const* in, BFloat16* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i].bits = floatToBFloat16Bits(in[i]);
+}
+
+__attribute__((target("f16c,avx2")))
+void halfToFloatF16C(Half const* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bits(in) + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+    }
+    halfToFloatScalar(in + i, out + i, n - i);
+}
+
+__attribute__((target("f16c,avx2")))
+void floatToHalfF16C(float const* in, Half* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bits(out) + i), h);
+    }
+    floatToHalfScalar(in + i, out + i, n - i);
+}
+
+// F16C has no bfloat16 instructions: a bfloat16 is the upper half of a float
+__attribute__((target("f16c,avx2")))
+void bfloat16ToFloatF16C(BFloat16 const* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i b = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(bits(in) + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_slli_epi32(b, 16));
+    }
+    bfloat16ToFloatScalar(in + i, out + i, n - i);
+}
+
+__attribute__((target("f16c,avx2")))
+void floatToBFloat16F16C(float const* in, BFloat16* out, std::size_t n) {
+    __m256i const one = _mm256_set1_epi32(1);
+    __m256i const bias = _mm256_set1_epi32(0x7FFF);
+    __m256i const quiet = _mm256_set1_epi32(0x00400000);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(in + i);
+        __m256i x = _mm256_castps_si256(v);
+        __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(x, 16), one);
+        __m256i rounded = _mm256_add_epi32(x, _mm256_add_epi32(bias, lsb));
+        __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+        __m256i b = _mm256_srli_epi32(_mm256_blendv_epi8(rounded, _mm256_or_si256(x, quiet), nan), 16);
+        // packus works per 128-bit lane, so the two halves are joined afterwards
+        b = _mm256_permute4x64_epi64(_mm256_packus_epi32(b, b), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bits(out) + i), _mm256_castsi256_si128(b));
+    }
+    floatToBFloat16Scalar(in + i, out + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+void halfToFloatAVX512(Half const* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i h = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(bits(in) + i));
+        _mm512_storeu_ps(out + i, _mm512_cvtph_ps(h));
+    }
+    halfToFloatScalar(in + i, out + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+void floatToHalfAVX512(float const* in, Half* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(bits(out) + i), h);
+    }
+    floatToHalfScalar(in + i, out + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+void bfloat16ToFloatAVX512(BFloat16 const* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i b = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(bits(in) + i)));
+        _mm512_storeu_si512(out + i, _mm512_slli_epi32(b, 16));
+    }
+    bfloat16ToFloatScalar(in + i, out + i, n - i);
+}
+
+// integer rounding as in the F16C version, so no AVX512_BF16 is required
+__attribute__((target("avx512f")))
+void floatToBFloat16AVX512(float const* in, BFloat16* out, std::size_t n) {
+    __m512i const one = _mm512_set1_epi32(1);
+    __m512i const bias = _mm512_set1_epi32(0x7FFF);
+    __m512i const quiet = _mm512_set1_epi32(0x00400000);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 v = _mm512_loadu_ps(in + i);
+        __m512i x = _mm512_castps_si512(v);
+        __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(x, 16), one);
+        __m512i rounded = _mm512_add_epi32(x, _mm512_add_epi32(bias, lsb));
+        __mmask16 nan = _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q);
+        __m512i b = _mm512_mask_or_epi32(rounded, nan, x, quiet);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(bits(out) + i),
+                            _mm512_cvtepi32_epi16(_mm512_srli_epi32(b, 16)));
+    }
+    floatToBFloat16Scalar(in + i, out + i, n - i);
+}
+
+bool convertKernelSupported(ConvertKernel kernel) {
+    switch (kernel) {
+        case ConvertKernel::Scalar: return true;
+        case ConvertKernel::F16C:   return __builtin_cpu_supports("f16c") && __builtin_cpu_supports("avx2");
+        case ConvertKernel::AVX512: return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+}
+
+ConvertKernel convertKernel() {
+    static const ConvertKernel kernel = [] {
+        if (convertKernelSupported(ConvertKernel::AVX512)) return ConvertKernel::AVX512;
+        if (convertKernelSupported(ConvertKernel::F16C)) return ConvertKernel::F16C;
+        return ConvertKernel::Scalar;
+    }();
+    return kernel;
+}
+
+char const* toString(ConvertKernel kernel) {
+    switch (kernel) {
+        case ConvertKernel::Scalar: return "scalar";
+        case ConvertKernel::F16C:   return "F16C";
+        case ConvertKernel::AVX512: return "AVX-512";
+    }
+    return "unknown";
+}
+
+void halfToFloat(Half const* in, float* out, std::size_t n) {
+    using Kernel = void (*)(Half const*, float*, std::size_t);
+    static const Kernel kernel = [] {
+        switch (convertKernel()) {
+            case ConvertKernel::AVX512: return &halfToFloatAVX512;
+            case ConvertKernel::F16C:   return &halfToFloatF16C;
+            default:                    return &halfToFloatScalar;
+        }
+    }();
+    kernel(in, out, n);
+}
+
+void floatToHalf(float const* in, Half* out, std::size_t n) {
+    using Kernel = void (*)(float const*, Half*, std::size_t);
+    static const Kernel kernel = [] {
+        switch (convertKernel()) {
+            case ConvertKernel::AVX512: return &floatToHalfAVX512;
+            case ConvertKernel::F16C:   return &floatToHalfF16C;
+            default:                    return &floatToHalfScalar;
+        }
+    }();
+    kernel(in, out, n);
+}
+
+void bfloat16ToFloat(BFloat16 const* in, float* out, std::size_t n) {
+    using Kernel = void (*)(BFloat16 const*, float*, std::size_t);
+    static const Kernel kernel = [] {
+        switch (convertKernel()) {
+            case ConvertKernel::AVX512: return &bfloat16ToFloatAVX512;
+            case ConvertKernel::F16C:   return &bfloat16ToFloatF16C;
+            default:                    return &bfloat16ToFloatScalar;
+        }
+    }();
+    kernel(in, out, n);
+}
+
+void floatToBFloat16(float const* in, BFloat16* out, std::size_t n) {
+    using Kernel = void (*)(float const*, BFloat16*, std::size_t);
+    static const Kernel kernel = [] {
+        switch (convertKernel()) {
+            case ConvertKernel::AVX512: return &floatToBFloat16AVX512;
+            case ConvertKernel::F16C:   return &floatToBFloat16F16C;
+            default:                    return &floatToBFloat16Scalar;
+        }
+    }();
+    kernel(in, out, n);
+}
+
+void convertScalars(ScalarType from, void const* input, ScalarType to, void* output, std::size_t n) {
+    if (from == to) {
+        std::memcpy(output, input, n * scalarTypeSize(from));
+        return;
+    }
+    if (from == ScalarType::Half && to == ScalarType::Float) {
+        return halfToFloat(static_cast<Half const*>(input), static_cast<float*>(output), n);
+    }
+    if (from == ScalarType::Float && to == ScalarType::Half) {
+        return floatToHalf(static_cast<float const*>(input), static_cast<Half*>(output), n);
+    }
+    if (from == ScalarType::BFloat16 && to == ScalarType::Float) {
+        return bfloat16ToFloat(static_cast<BFloat16 const*>(input), static_cast<float*>(output), n);
+    }
+    if (from == ScalarType::Float && to == ScalarType::BFloat16) {
+        return floatToBFloat16(static_cast<float const*>(input), static_cast<BFloat16*>(output), n);
+    }
+    dispatchScalarTypes<AllScalarTypeCombos<2>>([&](auto from_tag, auto to_tag) {
+        using from_t = typename decltype(from_tag)::type;
+        using to_t = typename decltype(to_tag)::type;
+        convertLoop<to_t, from_t>(input, output, n);
+    }, from, to);
+}
@@ -0,0 +1,52 @@
+#include "cpu_isa.H"
+
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+namespace {
+
+CpuIsa detectCpuIsa() {
+    CpuIsa best = CpuIsa::Scalar;
+    for (CpuIsa isa : {CpuIsa::SSE42, CpuIsa::AVX2, CpuIsa::AVX512}) {
+        if (cpuIsaSupported(isa)) best = isa;
+    }
+
+    if (char const* requested = std::getenv("DISPATCH_CPU_ISA")) {
+        for (CpuIsa isa : {CpuIsa::Scalar, CpuIsa::SSE42, CpuIsa::AVX2, CpuIsa::AVX512}) {
+            if (std::strcmp(requested, toString(isa)) == 0 && isa < best) best = isa;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+bool cpuIsaSupported(CpuIsa isa) {
+    // __builtin_cpu_supports reads CPUID, and for AVX also checks that the OS saves the registers
+    switch (isa) {
+        case CpuIsa::Scalar: return true;
+        case CpuIsa::SSE42:  return __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+        case CpuIsa::AVX2:   return cpuIsaSupported(CpuIsa::SSE42) && __builtin_cpu_supports("avx2") &&
+                                    __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+        case CpuIsa::AVX512: return cpuIsaSupported(CpuIsa::AVX2) && __builtin_cpu_supports("avx512f") &&
+                                    __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") &&
+                                    __builtin_cpu_supports("avx512vl");
+    }
+    return false;
+}
+
+CpuIsa cpuIsa() {
+    static const CpuIsa isa = detectCpuIsa();
+    return isa;
+}
+
+char const* toString(CpuIsa isa) {
+    switch (isa) {
+        case CpuIsa::Scalar: return "scalar";
+        case CpuIsa::SSE42:  return "sse4.2";
+        case CpuIsa::AVX2:   return "avx2";
+        case CpuIsa::AVX512: return "avx512";
+    }
+    return "unknown";
+}
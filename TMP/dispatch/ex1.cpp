@@ -1,61 +1,27 @@
 /* This code demonstrates a type-dispatch mechanism using variadic macros, templates, 
  * and enum-based scalar types. It allows dynamic selection of an example kernel 
  * implementations based on the `ScalarType` enum, which represents supported 
- * scalar data types such as `Float`, `Double`, and `Int`.
+ * scalar data types such as `Float`, `Double`, and `Int`, and the 16- and
+ * 8-bit storage types `Half`, `BFloat16`, `Int8` and `UInt8`.
+ *
+ * Tensor gives the kernels data to run on: add, mul, axpy, sum, max and dot
+ * dispatch once per call, on the tensors' ScalarType and on the CPU's ISA
+ * level (set DISPATCH_CPU_ISA=scalar, sse4.2 or avx2 to try a lower one).
+ * Arithmetic on tensors (tensor_expr.H) is lazy instead: a whole expression
+ * is dispatched once and evaluated in a single loop.
+ *
+ * dispatchScalarTypes does the same for kernels templated on several scalar
+ * types (e.g. input, accumulator and output), but only for an explicitly
+ * allowed set of type combinations.
  */
 
 #include <iostream>
-#include <string>
-#include <type_traits>
-
-// supported scalar types by the code
-enum class ScalarType { Float, Double, Int };
-
-// Helper to convert ScalarType to string
-std::string toString(ScalarType type) {
-    switch (type) {
-        case ScalarType::Float: return "Float";
-        case ScalarType::Double: return "Double";
-        case ScalarType::Int: return "Int";
-        default: return "Unknown";
-    }
-}
-
-// Helper to map ScalarType to actual C++ types
-template <ScalarType T>
-struct ScalarTypeToCPPType;
-
-template <>
-struct ScalarTypeToCPPType<ScalarType::Float> {
-    using type = float;
-};
-
-template <>
-struct ScalarTypeToCPPType<ScalarType::Double> {
-    using type = double;
-};
-
-template <>
-struct ScalarTypeToCPPType<ScalarType::Int> {
-    using type = int;
-};
-
-// Macro for dispatching to specific implementations based on ScalarType
-#define DISPATCH_CASE(enum_type, ...)                       \
-    case enum_type: {                                       \
-        using scalar_t = typename ScalarTypeToCPPType<enum_type>::type; \
-        return __VA_ARGS__();                               \
-    }
-
-// Main dispatch macro
-#define DISPATCH_SCALAR_TYPE(scalar_type, ...)               \
-    switch (scalar_type) {                                   \
-        DISPATCH_CASE(ScalarType::Float, __VA_ARGS__)        \
-        DISPATCH_CASE(ScalarType::Double, __VA_ARGS__)       \
-        DISPATCH_CASE(ScalarType::Int, __VA_ARGS__)          \
-        default:                                             \
-            throw std::runtime_error("Unsupported ScalarType"); \
-    }
+#include <typeinfo>
+#include <vector>
+#include "dispatch.H"
+#include "convert_kernels.H"
+#include "tensor_expr.H"
+#include "tensor_kernels.H"
 
 // Example kernel functions
 template <typename T>
@@ -72,9 +38,98 @@ void runKernel(ScalarType scalarType) {
     });
 }
 
+/* Example mixed-precision kernel: sums n values of type In in an accumulator
+ * of type Acc and stores the result as Out.
+ */
+template <typename In, typename Acc, typename Out>
+void sumKernel(const void* input, std::size_t n, void* output) {
+    const In* in = static_cast<const In*>(input);
+    Acc acc{};
+    for (std::size_t i = 0; i < n; ++i) acc += static_cast<Acc>(in[i]);
+    *static_cast<Out*>(output) = static_cast<Out>(acc);
+}
+
+// float input may accumulate in double without double being used everywhere
+using SumCombos = ScalarTypeCombos<
+    ScalarTypes<ScalarType::Float, ScalarType::Float, ScalarType::Float>,
+    ScalarTypes<ScalarType::Float, ScalarType::Double, ScalarType::Float>,
+    ScalarTypes<ScalarType::Double, ScalarType::Double, ScalarType::Double>,
+    ScalarTypes<ScalarType::Int, ScalarType::Int, ScalarType::Int>,
+    ScalarTypes<ScalarType::Int, ScalarType::Double, ScalarType::Double>,
+    ScalarTypes<ScalarType::Half, ScalarType::Double, ScalarType::Float>,
+    ScalarTypes<ScalarType::BFloat16, ScalarType::Double, ScalarType::Float>>;
+
+// Wrapper to use multi-type dispatch
+void runSumKernel(ScalarType in, ScalarType acc, ScalarType out,
+                  const void* input, std::size_t n, void* output) {
+    dispatchScalarTypes<SumCombos>([&](auto in_tag, auto acc_tag, auto out_tag) {
+        using in_t = typename decltype(in_tag)::type;
+        using acc_t = typename decltype(acc_tag)::type;
+        using out_t = typename decltype(out_tag)::type;
+        sumKernel<in_t, acc_t, out_t>(input, n, output);
+    }, in, acc, out);
+}
+
 int main() {
     runKernel(ScalarType::Float);  
     runKernel(ScalarType::Double); 
     runKernel(ScalarType::Int);    
+    runKernel(ScalarType::Half);
+    runKernel(ScalarType::BFloat16);
+    runKernel(ScalarType::Int8);
+    runKernel(ScalarType::UInt8);
+    runKernel(ScalarType::Int64);
+
+    // 10^7 * 0.1f: a float accumulator drifts, a double accumulator does not
+    std::vector<float> values(10000000, 0.1f);
+    float sum_float = 0.0f, sum_double = 0.0f;
+    runSumKernel(ScalarType::Float, ScalarType::Float, ScalarType::Float,
+                 values.data(), values.size(), &sum_float);
+    runSumKernel(ScalarType::Float, ScalarType::Double, ScalarType::Float,
+                 values.data(), values.size(), &sum_double);
+    std::cout << "sum in float accumulator: " << sum_float << "\n"
+              << "sum in double accumulator: " << sum_double << "\n";
+
+    // the same data in half and bfloat16 storage, at half the bytes per element
+    std::vector<Half> halves(values.size());
+    std::vector<BFloat16> bfloats(values.size());
+    convertScalars(ScalarType::Float, values.data(), ScalarType::Half, halves.data(), values.size());
+    convertScalars(ScalarType::Float, values.data(), ScalarType::BFloat16, bfloats.data(), values.size());
+    float sum_half = 0.0f, sum_bfloat = 0.0f;
+    runSumKernel(ScalarType::Half, ScalarType::Double, ScalarType::Float,
+                 halves.data(), halves.size(), &sum_half);
+    runSumKernel(ScalarType::BFloat16, ScalarType::Double, ScalarType::Float,
+                 bfloats.data(), bfloats.size(), &sum_bfloat);
+    std::cout << "sum of half values (" << toString(convertKernel()) << " conversion): " << sum_half << "\n"
+              << "sum of bfloat16 values: " << sum_bfloat << "\n";
+
+    // a batch of 10^6 values in every storage type, one dispatch per kernel call
+    std::cout << "Tensor kernels compiled for: " << toString(cpuIsa()) << "\n";
+    for (ScalarType type : {ScalarType::Float, ScalarType::Double, ScalarType::Half,
+                            ScalarType::BFloat16, ScalarType::Int8, ScalarType::Int64}) {
+        Tensor x(type, {1000, 1000}), y(type, {1000, 1000});
+        x.fill(1);
+        y.fill(2);
+        axpy(3, x, y);
+        std::cout << "Tensor " << toString(type) << ": sum(3x + y) = " << sum(y)
+                  << ", max = " << max(y) << ", dot(x, y) = " << dot(x, y)
+                  << ", sum(x^T + x) = " << sum(add(x.transpose(0, 1), x)) << "\n";
+    }
+
+    // 2x + 3y - z in one pass over x, y and z, without temporaries
+    Tensor x(ScalarType::Float, {1000, 1000}), y(ScalarType::Float, {1000, 1000}), z(ScalarType::Float, {1000, 1000});
+    x.fill(1);
+    y.fill(2);
+    z.fill(3);
+    std::cout << "Fused: sum(2x + 3y - z) = " << sum(evaluate(2 * x + 3 * y - z)) << "\n";
+
+    try {
+        double result;
+        runSumKernel(ScalarType::Double, ScalarType::Float, ScalarType::Double,
+                     values.data(), values.size(), &result);
+    }
+    catch (const std::runtime_error& e) {
+        std::cout << e.what() << "\n";
+    }
     return 0;
 }
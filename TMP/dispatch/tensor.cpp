@@ -0,0 +1,112 @@
+#include "tensor.H"
+#include "convert_kernels.H"
+#include "dispatch.H"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace {
+
+struct AlignedDelete {
+    void operator()(std::byte* p) const {
+        ::operator delete(p, std::align_val_t(Tensor::alignment));
+    }
+};
+
+} // namespace
+
+Tensor::Tensor(ScalarType dtype, std::vector<std::int64_t> shape) :
+    dtype_(dtype), shape_(std::move(shape)), strides_(shape_.size()), numel_(1) {
+    if (scalarTypeSize(dtype_) == 0) {
+        throw std::runtime_error("Unsupported ScalarType");
+    }
+    for (std::size_t d = shape_.size(); d-- > 0;) {
+        if (shape_[d] < 0) {
+            throw std::runtime_error("Tensor: negative extent in dimension " + std::to_string(d));
+        }
+        strides_[d] = static_cast<std::int64_t>(numel_);
+        numel_ *= static_cast<std::size_t>(shape_[d]);
+    }
+
+    // never empty, so that data() of an empty tensor is still aligned and non-null
+    std::size_t bytes = std::max(numel_ * itemsize(), alignment);
+    auto* p = static_cast<std::byte*>(::operator new(bytes, std::align_val_t(alignment)));
+    std::memset(p, 0, bytes);
+    storage_ = std::shared_ptr<std::byte>(p, AlignedDelete{});
+}
+
+bool Tensor::isContiguous() const {
+    std::int64_t expected = 1;
+    for (std::size_t d = shape_.size(); d-- > 0;) {
+        if (shape_[d] != 1 && strides_[d] != expected) return false;
+        expected *= shape_[d];
+    }
+    return true;
+}
+
+std::size_t Tensor::offset(std::initializer_list<std::int64_t> index) const {
+    if (index.size() != shape_.size()) {
+        throw std::runtime_error("Tensor: " + std::to_string(index.size()) + " indices for " +
+                                 std::to_string(shape_.size()) + " dimensions");
+    }
+    std::int64_t offset = 0;
+    std::size_t d = 0;
+    for (std::int64_t i : index) {
+        if (i < 0 || i >= shape_[d]) {
+            throw std::out_of_range("Tensor: index " + std::to_string(i) + " out of range in dimension " +
+                                    std::to_string(d));
+        }
+        offset += i * strides_[d++];
+    }
+    return static_cast<std::size_t>(offset);
+}
+
+Tensor Tensor::transpose(std::size_t dim0, std::size_t dim1) const {
+    if (dim0 >= dim() || dim1 >= dim()) {
+        throw std::out_of_range("Tensor::transpose: dimension out of range");
+    }
+    Tensor view = *this;
+    std::swap(view.shape_[dim0], view.shape_[dim1]);
+    std::swap(view.strides_[dim0], view.strides_[dim1]);
+    return view;
+}
+
+Tensor Tensor::contiguous() const {
+    if (isContiguous()) return *this;
+
+    Tensor result(dtype_, shape_);
+    // DISPATCH_SCALAR_TYPE returns from the enclosing function, here the outer lambda
+    [&]() {
+        DISPATCH_SCALAR_TYPE(dtype_, [&]() {
+            scalar_t const* in = data<scalar_t>();
+            scalar_t* out = result.data<scalar_t>();
+            forEachOffset<2>(shape_, {&strides_, &result.strides_}, [&](auto const& offsets) {
+                out[offsets[1]] = in[offsets[0]];
+            });
+        });
+    }();
+    return result;
+}
+
+Tensor Tensor::to(ScalarType dtype) const {
+    Tensor source = contiguous();
+    Tensor result(dtype, shape_);
+    convertScalars(dtype_, source.data(), dtype, result.data(), numel_);
+    return result;
+}
+
+void Tensor::fill(double value) {
+    DISPATCH_SCALAR_TYPE(dtype_, [&]() {
+        auto v = static_cast<scalar_t>(value);
+        scalar_t* out = data<scalar_t>();
+        if (isContiguous()) {
+            std::fill(out, out + numel_, v);
+            return;
+        }
+        forEachOffset<1>(shape_, {&strides_}, [&](auto const& offsets) {
+            out[offsets[0]] = v;
+        });
+    });
+}
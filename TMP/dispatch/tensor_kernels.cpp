@@ -0,0 +1,68 @@
+#include "tensor_kernels.H"
+#include "dispatch.H"
+
+#include <string>
+
+namespace {
+
+void checkOperands(char const* kernel, Tensor const& a, Tensor const& b) {
+    if (a.dtype() != b.dtype()) {
+        throw std::runtime_error(std::string(kernel) + ": ScalarType mismatch (" + toString(a.dtype()) +
+                                 ", " + toString(b.dtype()) + ")");
+    }
+    if (a.shape() != b.shape()) {
+        throw std::runtime_error(std::string(kernel) + ": shape mismatch");
+    }
+}
+
+// the kernels of the CPU's ISA level for type, the table is picked on first use
+TensorKernels const& kernels(ScalarType type) {
+    static TensorKernelTable const& table = tensorKernelTable(cpuIsa());
+    return table[scalarTypeIndex(type)];
+}
+
+} // namespace
+
+TensorKernelTable const& tensorKernelTable(CpuIsa isa) {
+    switch (isa) {
+        case CpuIsa::AVX512: return tensorKernelTableAVX512();
+        case CpuIsa::AVX2:   return tensorKernelTableAVX2();
+        case CpuIsa::SSE42:  return tensorKernelTableSSE42();
+        default:             return tensorKernelTableScalar();
+    }
+}
+
+Tensor add(Tensor const& a, Tensor const& b) {
+    checkOperands("add", a, b);
+    Tensor out(a.dtype(), a.shape());
+    kernels(a.dtype()).add(a, b, out);
+    return out;
+}
+
+Tensor mul(Tensor const& a, Tensor const& b) {
+    checkOperands("mul", a, b);
+    Tensor out(a.dtype(), a.shape());
+    kernels(a.dtype()).mul(a, b, out);
+    return out;
+}
+
+void axpy(double alpha, Tensor const& x, Tensor& y) {
+    checkOperands("axpy", x, y);
+    kernels(x.dtype()).axpy(alpha, x, y);
+}
+
+double sum(Tensor const& a) {
+    return kernels(a.dtype()).sum(a.contiguous());
+}
+
+double max(Tensor const& a) {
+    if (a.numel() == 0) {
+        throw std::runtime_error("max: empty tensor");
+    }
+    return kernels(a.dtype()).max(a.contiguous());
+}
+
+double dot(Tensor const& a, Tensor const& b) {
+    checkOperands("dot", a, b);
+    return kernels(a.dtype()).dot(a.contiguous(), b.contiguous());
+}
@@ -0,0 +1,25 @@
+#include "tensor_kernels.H"
+#include "convert_kernels.H"
+#include "dispatch.H"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma,f16c")
+
+namespace {
+
+constexpr CpuIsa isa = CpuIsa::AVX2;
+
+#include "tensor_kernels_impl.H"
+
+} // namespace
+
+#pragma GCC pop_options
+
+TensorKernelTable const& tensorKernelTableAVX2() {
+    static constexpr TensorKernelTable table = makeScalarTypeTable<TensorKernels, TensorKernelEntries>();
+    return table;
+}
@@ -0,0 +1,20 @@
+#include "tensor_kernels.H"
+#include "convert_kernels.H"
+#include "dispatch.H"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+namespace {
+
+constexpr CpuIsa isa = CpuIsa::Scalar;
+
+#include "tensor_kernels_impl.H"
+
+} // namespace
+
+TensorKernelTable const& tensorKernelTableScalar() {
+    static constexpr TensorKernelTable table = makeScalarTypeTable<TensorKernels, TensorKernelEntries>();
+    return table;
+}
@@ -0,0 +1,25 @@
+#include "tensor_kernels.H"
+#include "convert_kernels.H"
+#include "dispatch.H"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#pragma GCC push_options
+#pragma GCC target("sse4.2,popcnt")
+
+namespace {
+
+constexpr CpuIsa isa = CpuIsa::SSE42;
+
+#include "tensor_kernels_impl.H"
+
+} // namespace
+
+#pragma GCC pop_options
+
+TensorKernelTable const& tensorKernelTableSSE42() {
+    static constexpr TensorKernelTable table = makeScalarTypeTable<TensorKernels, TensorKernelEntries>();
+    return table;
+}
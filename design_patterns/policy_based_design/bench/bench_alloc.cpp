@@ -0,0 +1,96 @@
+/* Heap allocations and time per log call for the string-building path
+ * (what MsgLogger::operator() used to do with std::string temporaries and
+ * std::ostringstream) versus MsgLogger::log(), which formats into the 
+ * per-thread line buffer.
+ *
+ * usage: bench_alloc [iterations]
+ */
+
+#include "../msglogger.H"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+
+// keeps the compiler from discarding the formatted lines
+volatile std::size_t sink = 0;
+
+// measures formatting only
+struct WriteToNull
+{
+    void operator() (std::string_view msg) { sink += msg.size(); }
+};
+
+template <typename F>
+void measure(const char* name, std::size_t iterations, F&& f)
+{
+    // steady state: let the line buffers reach their final size
+    for (std::size_t i = 0; i < 1000; ++i) f(i);
+
+    std::size_t allocs_before = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) f(i);
+    auto end = std::chrono::steady_clock::now();
+    std::size_t allocs = allocations.load() - allocs_before;
+
+    std::cout << std::left << std::setw(40) << name << std::right << std::fixed
+              << std::setw(10) << std::setprecision(1)
+              << std::chrono::duration<double, std::nano>(end - start).count() / iterations 
+              << " ns/call"
+              << std::setw(10) << std::setprecision(2)
+              << static_cast<double>(allocs) / iterations << " allocs/call\n";
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::complex<int> v{3, 4};
+
+    {
+        using Stamp = WithStamp_TimeMicroSecPrecis;
+        WriteToNull stream;
+        measure("string building, microsec stamp", iterations, [&](std::size_t i) {
+            std::ostringstream oss;
+            oss << " vec[" << i << "]: " << v.real() << " + " << v.imag() << "i";
+            std::string duration = std::string{};
+            stream(Stamp::get_stamp() + oss.str() + duration);
+        });
+    }
+    {
+        MsgLogger<WriteToNull, WithStamp_TimeMicroSecPrecis> logger;
+        measure("log(), microsec stamp", iterations, [&](std::size_t i) {
+            logger.log(" vec[", i, "]: ", v.real(), " + ", v.imag(), "i");
+        });
+    }
+    {
+        MsgLogger<WriteToNull, WithStamp_CachedTimeMicroSecPrecis> logger;
+        measure("log(), cached microsec stamp", iterations, [&](std::size_t i) {
+            logger.log(" vec[", i, "]: ", v.real(), " + ", v.imag(), "i");
+        });
+        measure("operator(), cached microsec stamp", iterations, [&](std::size_t) {
+            logger("file_logger is logging...");
+        });
+    }
+    {
+        std::string long_line(4096, 'x');
+        MsgLogger<WriteToNull, WithStamp_CachedTimeMicroSecPrecis> logger;
+        measure("log(), 4 KiB line (spills once)", iterations, [&](std::size_t i) {
+            logger.log(long_line, i);
+        });
+    }
+}
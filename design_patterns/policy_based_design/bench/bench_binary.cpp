@@ -0,0 +1,58 @@
+/* Cost of logging the numeric payloads of log_vector and log_matrix as text
+ * (WriteToFile with the cached stamp) versus binary records (BinaryWriteToFile).
+ *
+ * usage: bench_binary [elements]
+ */
+
+#include "../msglogger.H"
+
+#include <cstdlib>
+
+namespace {
+
+template <typename F>
+double ns_per_element(std::size_t elements, F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / elements;
+}
+
+void report(const char* name, double ns)
+{
+    std::cout << std::left << std::setw(40) << name << std::right << std::fixed
+              << std::setw(10) << std::setprecision(1) << ns << " ns/element\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    std::vector<std::complex<double>> vec(elements);
+    for (std::size_t i = 0; i < elements; ++i) {
+        vec[i] = {0.5 * static_cast<double>(i), -1.25 * static_cast<double>(i)};
+    }
+
+    std::size_t columns = 16;
+    std::vector<std::vector<int>> matrix(elements / columns, std::vector<int>(columns));
+    for (std::size_t i = 0; i < matrix.size(); ++i) {
+        for (std::size_t j = 0; j < columns; ++j) matrix[i][j] = static_cast<int>(i * columns + j);
+    }
+
+    {
+        MsgLogger<WriteToFile, WithStamp_CachedTimeMicroSecPrecis, WithCallable> 
+            logger{"text", WriteToFile("bench_text.log")};
+        report("log_vector, WriteToFile", ns_per_element(elements, [&] { log_vector(logger, vec); }));
+        report("log_matrix, WriteToFile", ns_per_element(elements, [&] { log_matrix(logger, matrix); }));
+    }
+    {
+        MsgLogger<BinaryWriteToFile, NoStamp, WithCallable> 
+            logger{"binary", BinaryWriteToFile("bench_binary.seg", std::size_t(512) << 20)};
+        report("log_vector, BinaryWriteToFile", ns_per_element(elements, [&] { log_vector(logger, vec); }));
+        report("log_matrix, BinaryWriteToFile", ns_per_element(elements, [&] { log_matrix(logger, matrix); }));
+        std::cout << "binary records dropped: " << logger.stream_policy().dropped() << "\n";
+    }
+}
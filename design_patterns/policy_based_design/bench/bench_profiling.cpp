@@ -0,0 +1,59 @@
+/* Overhead of the CallablePolicy implementations for an empty callable, in
+ * ns/call: WithCallable formats the duration, ProfilingPolicy records it into
+ * a histogram.
+ *
+ * usage: bench_profiling [iterations]
+ */
+
+#include "../msglogger.H"
+
+#include <cstdlib>
+
+namespace {
+
+volatile std::size_t sink = 0;
+
+template <typename F>
+double ns_per_call(std::size_t iterations, F&& f)
+{
+    for (std::size_t i = 0; i < iterations / 10; ++i) f();
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+void report(const char* name, double ns)
+{
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed
+              << std::setw(10) << std::setprecision(1) << ns << " ns/call\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+    auto work = [] { sink = sink + 1; };
+
+    report("NoCallable", ns_per_call(iterations, [&] {
+        DurationBuffer duration;
+        NoCallable::call(duration, work);
+        sink = sink + duration.view().size();
+    }));
+    report("WithCallable", ns_per_call(iterations, [&] {
+        DurationBuffer duration;
+        WithCallable::call(duration, work);
+        sink = sink + duration.view().size();
+    }));
+    report("ProfilingPolicy", ns_per_call(iterations, [&] {
+        DurationBuffer duration;
+        ProfilingPolicy::call(duration, work);
+        sink = sink + duration.view().size();
+    }));
+
+    std::cout << "\n";
+    ProfilingPolicy::dump(std::cout);
+}
@@ -0,0 +1,87 @@
+/* Throughput (bytes/sec) and p50/p99 latency of a single write for WriteToFile
+ * and MmapRotatingFile, with one or more threads writing through the same
+ * stream policy.
+ *
+ * usage: bench_rotating [lines per thread] [max threads]
+ */
+
+#include "../msglogger.H"
+
+#include <cstdlib>
+
+namespace {
+
+struct Result
+{
+    double bytes_per_sec;
+    double p50_ns;
+    double p99_ns;
+};
+
+template <typename Stream>
+Result run(Stream& stream, std::size_t lines, std::size_t threads, std::string_view line)
+{
+    std::vector<std::vector<std::uint32_t>> latencies(threads, std::vector<std::uint32_t>(lines));
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            auto& lat = latencies[t];
+            for (std::size_t i = 0; i < lines; ++i) {
+                auto t0 = std::chrono::steady_clock::now();
+                stream(line);
+                auto t1 = std::chrono::steady_clock::now();
+                lat[i] = static_cast<std::uint32_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    auto end = std::chrono::steady_clock::now();
+
+    std::vector<std::uint32_t> all;
+    all.reserve(lines * threads);
+    for (auto& lat : latencies) all.insert(all.end(), lat.begin(), lat.end());
+    auto percentile = [&](double p) {
+        auto k = static_cast<std::size_t>(p * static_cast<double>(all.size() - 1));
+        std::nth_element(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(k), all.end());
+        return static_cast<double>(all[k]);
+    };
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double bytes = static_cast<double>((line.size() + 1) * lines * threads);
+    return {bytes / seconds, percentile(0.50), percentile(0.99)};
+}
+
+void report(const char* name, std::size_t threads, const Result& r)
+{
+    std::cout << std::left << std::setw(20) << name << std::right
+              << std::setw(4) << threads << " threads"
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << r.bytes_per_sec / (1 << 20) << " MiB/s"
+              << std::setw(10) << r.p50_ns << " ns p50"
+              << std::setw(10) << r.p99_ns << " ns p99\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500000;
+    std::size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4;
+
+    std::string line = "[12:34:56.123456] a typical log line with a few numbers: 42, 3.14, (1,-1)";
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        {
+            WriteToFile stream("bench_writetofile.log");
+            report("WriteToFile", threads, run(stream, lines, threads, line));
+        }
+        {
+            MmapRotatingFile stream("bench_rotating.log", std::size_t(32) << 20, 
+                                    std::chrono::seconds(0), 4);
+            report("MmapRotatingFile", threads, run(stream, lines, threads, line));
+        }
+    }
+}
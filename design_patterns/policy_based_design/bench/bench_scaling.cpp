@@ -0,0 +1,59 @@
+/* Logs/second with 1..N threads sharing one logger, for the mutex-based
+ * WriteToFile and for ThreadLocalBufferedStream.
+ *
+ * "producer" counts the time until all threads have logged their lines,
+ * "end-to-end" additionally includes destroying the logger, i.e. until
+ * every line is in the file.
+ *
+ * usage: bench_scaling [lines per thread] [max threads]
+ */
+
+#include "../msglogger.H"
+
+#include <cstdlib>
+
+namespace {
+
+template <typename Stream>
+void run(const char* name, std::size_t threads, std::size_t lines, Stream&& stream)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point produced;
+    {
+        MsgLogger<std::decay_t<Stream>, WithStamp_CachedTimeMicroSecPrecis> logger{"", std::move(stream)};
+
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&logger, t, lines] {
+                for (std::size_t i = 0; i < lines; ++i) {
+                    logger.log("thread ", t, " logs message ", i, " with value ", 0.5 * static_cast<double>(i));
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        produced = std::chrono::steady_clock::now();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double total = static_cast<double>(threads * lines);
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(4) << threads << " threads" << std::fixed << std::setprecision(2)
+              << std::setw(10) << total / std::chrono::duration<double>(produced - start).count() / 1e6
+              << " M logs/s producer"
+              << std::setw(10) << total / std::chrono::duration<double>(end - start).count() / 1e6
+              << " M logs/s end-to-end\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    std::size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        run("WriteToFile", threads, lines, WriteToFile("bench_scaling_mutex.log"));
+        run("ThreadLocalBufferedStream", threads, lines, 
+            ThreadLocalBufferedStream("bench_scaling_buffered.log"));
+    }
+}
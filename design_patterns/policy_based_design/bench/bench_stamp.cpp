@@ -0,0 +1,56 @@
+/* Microbenchmark of the StampPolicy implementations in ns/stamp.
+ *
+ * usage: bench_stamp [iterations]
+ */
+
+#include "../msglogger.H"
+
+#include <cstdlib>
+
+namespace {
+
+// keeps the compiler from discarding the stamps
+volatile std::size_t sink = 0;
+
+template <typename F>
+double ns_per_call(std::size_t iterations, F&& f)
+{
+    // warm-up, also fills the per-second cache of the cached policy
+    for (std::size_t i = 0; i < iterations / 10; ++i) f();
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+void report(const char* name, double ns)
+{
+    std::cout << std::left << std::setw(48) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1)
+              << ns << " ns/stamp\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    report("WithStamp_TimeSecPrecis::get_stamp",
+           ns_per_call(iterations, [] { sink += WithStamp_TimeSecPrecis::get_stamp().size(); }));
+
+    report("WithStamp_TimeMicroSecPrecis::get_stamp",
+           ns_per_call(iterations, [] { sink += WithStamp_TimeMicroSecPrecis::get_stamp().size(); }));
+
+    report("WithStamp_CachedTimeMicroSecPrecis::get_stamp",
+           ns_per_call(iterations, [] { sink += WithStamp_CachedTimeMicroSecPrecis::get_stamp().size(); }));
+
+    char buffer[WithStamp_CachedTimeMicroSecPrecis::stamp_size];
+    report("WithStamp_CachedTimeMicroSecPrecis::write_stamp",
+           ns_per_call(iterations, [&] {
+               sink += WithStamp_CachedTimeMicroSecPrecis::write_stamp(buffer);
+               sink += static_cast<unsigned char>(buffer[11]);
+           }));
+}
@@ -0,0 +1,191 @@
+/* msglog_decode: turns segments written by BinaryWriteToFile back into text.
+ *
+ * usage: msglog_decode <segment>...
+ *
+ * Every record is printed as one line, prefixed with its local time in the
+ * same "[HH:MM:SS.uuuuuu] " format as WithStamp_TimeMicroSecPrecis.
+ * Format definitions are collected in a first pass, so events may appear
+ * in a segment before the definition of their format. A record whose
+ * payload ends early (e.g. torn by a crash) is printed as far as it goes,
+ * followed by "<truncated record>".
+ */
+
+#include "../binary_log.H"
+
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <ctime>
+#include <cstdio>
+
+namespace {
+
+struct FormatDefinition
+{
+    std::string signature;
+    std::string format;
+};
+
+using LineBuffer = LogBuffer<4096>;
+
+void require(const char* data, const char* end, std::size_t n)
+{
+    if (static_cast<std::size_t>(end - data) < n) throw BinaryTruncatedRecord();
+}
+
+std::uint32_t read_u32(const char*& data, const char* end)
+{
+    require(data, end, sizeof(std::uint32_t));
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    data += sizeof(value);
+    return value;
+}
+
+std::string_view read_string(const char*& data, const char* end)
+{
+    std::uint32_t length = read_u32(data, end);
+    require(data, end, length);
+    std::string_view str(data, length);
+    data += length;
+    return str;
+}
+
+void append_stamp(LineBuffer& line, const BinaryLogHeader& header, std::uint64_t timestamp)
+{
+    // in unsigned arithmetic, so that a corrupt timestamp cannot overflow
+    auto wall_ns = static_cast<std::int64_t>(static_cast<std::uint64_t>(header.system_anchor_ns) +
+                                             (timestamp - static_cast<std::uint64_t>(header.steady_anchor_ns)));
+    std::time_t seconds = static_cast<std::time_t>(wall_ns / 1000000000);
+    long microseconds = static_cast<long>((wall_ns / 1000) % 1000000);
+
+    std::tm tm_now;
+    if (wall_ns < 0 || !localtime_r(&seconds, &tm_now)) {
+        line.append("[invalid time] ");
+        return;
+    }
+    char stamp[32];
+    int n = std::snprintf(stamp, sizeof(stamp), "[%02d:%02d:%02d.%06ld] ",
+                          tm_now.tm_hour, tm_now.tm_min, tm_now.tm_sec, microseconds);
+    line.append(std::string_view(stamp, static_cast<std::size_t>(n)));
+}
+
+/* Same substitution as LogBuffer::append_format, driven by the signature. */
+void render_event(LineBuffer& line, const FormatDefinition& def, const char* data, const char* end)
+{
+    std::string_view fmt = def.format;
+    const char* sig = def.signature.c_str();
+
+    while (*sig) {
+        auto pos = fmt.find("{}");
+        if (pos == std::string_view::npos) break;
+        line.append(fmt.substr(0, pos));
+        data = render_binary_arg(line, sig, data, end);
+        fmt.remove_prefix(pos + 2);
+    }
+    line.append(fmt);
+}
+
+/* Calls f(record, payload, end) for every complete record; end is the end
+ * of the record's payload.
+ */
+template <typename F>
+void for_each_record(const std::string& segment, F&& f)
+{
+    std::size_t offset = sizeof(BinaryLogHeader);
+    while (offset + sizeof(BinaryRecordHeader) <= segment.size()) {
+        BinaryRecordHeader record;
+        std::memcpy(&record, segment.data() + offset, sizeof(record));
+        if (record.size < sizeof(record) || offset + record.size > segment.size()) break;
+        const char* payload = segment.data() + offset + sizeof(record);
+        f(record, payload, segment.data() + offset + record.size);
+        offset += record.size;
+    }
+}
+
+void decode(const std::string& filename, std::ostream& out)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file: " + filename);
+    }
+    std::string segment((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    BinaryLogHeader header;
+    if (segment.size() < sizeof(header)) {
+        throw std::runtime_error("Not a binary log segment: " + filename);
+    }
+    std::memcpy(&header, segment.data(), sizeof(header));
+    if (std::memcmp(header.magic, binary_log_magic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a binary log segment: " + filename);
+    }
+    if (header.version != binary_log_version) {
+        throw std::runtime_error("Unsupported binary log version in: " + filename);
+    }
+
+    std::unordered_map<std::uint32_t, FormatDefinition> formats;
+    for_each_record(segment, [&](const BinaryRecordHeader& record, const char* payload, const char* end) {
+        if (record.format_id != binary_define_id) return;
+        try {
+            std::uint32_t id = read_u32(payload, end);
+            FormatDefinition def;
+            def.signature = std::string(read_string(payload, end));
+            def.format = std::string(read_string(payload, end));
+            formats.emplace(id, std::move(def));
+        }
+        catch (const BinaryTruncatedRecord&) {
+            // its events are printed as "<undefined format ...>"
+        }
+    });
+
+    LineBuffer line;
+    for_each_record(segment, [&](const BinaryRecordHeader& record, const char* payload, const char* end) {
+        if (record.format_id == binary_define_id) return;
+
+        line.clear();
+        append_stamp(line, header, record.timestamp);
+        try {
+            if (record.format_id == binary_text_id) {
+                line.append(read_string(payload, end));
+            }
+            else {
+                auto def = formats.find(record.format_id);
+                if (def == formats.end()) {
+                    line.append("<undefined format ");
+                    line.append(record.format_id);
+                    line.append('>');
+                }
+                else {
+                    render_event(line, def->second, payload, end);
+                }
+            }
+        }
+        catch (const BinaryTruncatedRecord&) {
+            line.append("<truncated record>");
+        }
+        line.append('\n');
+        auto text = line.view();
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    });
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <segment>...\n";
+        return 1;
+    }
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            decode(argv[i], std::cout);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}
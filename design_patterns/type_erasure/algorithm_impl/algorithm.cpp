@@ -1,11 +1,23 @@
 #include "algorithm.H"
 
 void computeAlgorithm(std::vector<Algorithm> const& materials) {
-    for(auto const& material: materials) {
-        computeStep1(material);
+    Algorithm const* last = materials.data() + materials.size();
+    for(Algorithm const* material = materials.data(); material != last; ) {
+        material += material->pimpl->computeStep1Run(material, last);
+    }
+}
+
+void computeAlgorithm(std::pmr::vector<Algorithm> const& materials) {
+    Algorithm const* last = materials.data() + materials.size();
+    for(Algorithm const* material = materials.data(); material != last; ) {
+        material += material->pimpl->computeStep1Run(material, last);
     }
 }
 
 void computeStep1(Algorithm const& material) {
     material.pimpl->computeStep1();
 }
+
+std::size_t costHint(Algorithm const& material) {
+    return material.pimpl->costHint();
+}
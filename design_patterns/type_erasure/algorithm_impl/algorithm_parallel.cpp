@@ -0,0 +1,75 @@
+#include "algorithm_parallel.H"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+void computeAlgorithmParallel(std::vector<Algorithm> const& materials, WorkStealingPool& pool,
+                              std::size_t chunks_per_worker) {
+    const std::size_t n = materials.size();
+    const std::size_t workers = pool.size();
+    chunks_per_worker = std::max<std::size_t>(chunks_per_worker, 1);
+
+    std::atomic<std::size_t> published{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto process = [&](WorkStealingPool::Range range) {
+        try {
+            for (std::size_t i = range.begin; i < range.end; ++i) {
+                computeStep1(materials[i]);
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    pool.run([&](std::size_t worker) {
+        // cut the own slice into chunks of about equal cost
+        const std::size_t begin = n * worker / workers;
+        const std::size_t end = n * (worker + 1) / workers;
+
+        std::size_t slice_cost = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            slice_cost += costHint(materials[i]);
+        }
+        const std::size_t target = std::max<std::size_t>(slice_cost / chunks_per_worker, 1);
+
+        std::size_t chunk_begin = begin;
+        std::size_t chunk_cost = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            chunk_cost += costHint(materials[i]);
+            if (chunk_cost >= target || i + 1 == end) {
+                pool.push(worker, {chunk_begin, i + 1});
+                chunk_begin = i + 1;
+                chunk_cost = 0;
+            }
+        }
+        published.fetch_add(1, std::memory_order_release);
+
+        /* Own chunks first, then the others'. Once every worker has published
+         * its chunks, finding no chunk anywhere means that the job is done.
+         */
+        WorkStealingPool::Range range;
+        for (;;) {
+            bool all_published = published.load(std::memory_order_acquire) == workers;
+            if (pool.pop(worker, range) || pool.steal(worker, range)) {
+                process(range);
+                continue;
+            }
+            if (all_published) break;
+            std::this_thread::yield();
+        }
+    });
+
+    if (error) std::rethrow_exception(error);
+}
+
+void computeAlgorithmParallel(std::vector<Algorithm> const& materials, std::size_t threads) {
+    WorkStealingPool pool(threads);
+    computeAlgorithmParallel(materials, pool);
+}
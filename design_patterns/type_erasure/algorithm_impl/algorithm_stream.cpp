@@ -0,0 +1,43 @@
+#include "algorithm_stream.H"
+
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+
+bool makeMaterial(std::pmr::vector<Algorithm>& batch, std::string_view type, int unitcells) {
+    if (type == "CNT") batch.emplace_back(CNT{unitcells});
+    else if (type == "Graphene") batch.emplace_back(Graphene{unitcells});
+    else return false;
+    return true;
+}
+
+TextFileSource::TextFileSource(std::string const& filename, MaterialFactory factory) :
+    file{filename}, filename{filename}, factory{std::move(factory)} {
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file: " + filename);
+    }
+}
+
+std::size_t TextFileSource::operator()(std::pmr::vector<Algorithm>& batch, std::size_t max) {
+    std::size_t n = 0;
+    while (n < max && std::getline(file, line)) {
+        ++line_number;
+        std::string_view text = line;
+        if (text.empty()) continue;
+
+        auto space = text.find(' ');
+        std::string_view type = text.substr(0, space);
+        int unitcells = 0;
+        auto [end, ec] = std::from_chars(text.data() + (space == std::string_view::npos ? text.size() : space + 1),
+                                         text.data() + text.size(), unitcells);
+        if (space == std::string_view::npos || ec != std::errc() || end != text.data() + text.size()) {
+            throw std::runtime_error("Malformed material in " + filename + ":" + std::to_string(line_number));
+        }
+
+        if (!factory(batch, type, unitcells)) {
+            throw std::runtime_error("Unknown material type in " + filename + ":" + std::to_string(line_number));
+        }
+        ++n;
+    }
+    return n;
+}
@@ -1,6 +1,28 @@
 #include "materials_impl.H"
+#include "unitcell_kernels.H"
 #include <iostream>
 
 void computeStep1(CNT const& cnt) {
     std::cout << "processing step 1 for CNT with unitcells: " << cnt.get_unitcells() << "\n";
 }
+
+void computeStep1(std::span<const CNT> cnts) {
+    std::cout << "processing step 1 for " << cnts.size() << " CNT with unitcells: "
+              << sumUnitcells(unitcellData(cnts), cnts.size()) << "\n";
+}
+
+void computeStep2(CNT const& cnt) {
+    std::cout << "processing step 2 for CNT with unitcells: " << cnt.get_unitcells() << "\n";
+}
+
+void computeStep3(CNT const& cnt) {
+    std::cout << "processing step 3 for CNT with unitcells: " << cnt.get_unitcells() << "\n";
+}
+
+void updateStep1(CNT& cnt) {
+    std::cout << "updating step 1 for CNT with unitcells: " << cnt.get_unitcells() << "\n";
+}
+
+std::size_t costHint(CNT const& cnt) {
+    return static_cast<std::size_t>(cnt.get_unitcells());
+}
@@ -1,6 +1,28 @@
 #include "materials_impl.H"
+#include "unitcell_kernels.H"
 #include <iostream>
 
 void computeStep1(Graphene const& graphene) {
     std::cout << "processing step 1 for Graphene with unitcells: " << graphene.get_unitcells() << "\n";
 }
+
+void computeStep1(std::span<const Graphene> graphenes) {
+    std::cout << "processing step 1 for " << graphenes.size() << " Graphene with unitcells: "
+              << sumUnitcells(unitcellData(graphenes), graphenes.size()) << "\n";
+}
+
+void computeStep2(Graphene const& graphene) {
+    std::cout << "processing step 2 for Graphene with unitcells: " << graphene.get_unitcells() << "\n";
+}
+
+void computeStep3(Graphene const& graphene) {
+    std::cout << "processing step 3 for Graphene with unitcells: " << graphene.get_unitcells() << "\n";
+}
+
+void updateStep1(Graphene& graphene) {
+    std::cout << "updating step 1 for Graphene with unitcells: " << graphene.get_unitcells() << "\n";
+}
+
+std::size_t costHint(Graphene const& graphene) {
+    return static_cast<std::size_t>(graphene.get_unitcells());
+}
@@ -0,0 +1,137 @@
+#include "material_database.H"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MaterialDatabaseWriter::MaterialDatabaseWriter(std::string const& filename) : filename{filename} {
+    fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Error opening file: " + filename);
+    }
+    // the header is rewritten with the record count by close()
+    MaterialDatabaseHeader header{};
+    std::memcpy(header.magic, material_database_magic, sizeof(header.magic));
+    header.version = material_database_version;
+    header.record_size = static_cast<std::uint32_t>(material_record_size);
+    write(reinterpret_cast<char const*>(&header), sizeof(header));
+}
+
+MaterialDatabaseWriter::~MaterialDatabaseWriter() {
+    try {
+        close();
+    }
+    catch (...) {
+        // nothing sensible to do in a destructor
+    }
+}
+
+void MaterialDatabaseWriter::write(char const* data, std::size_t size) {
+    buffer.append(data, size);
+    if (buffer.size() >= (std::size_t(1) << 20)) flush();
+}
+
+void MaterialDatabaseWriter::flush() {
+    char const* data = buffer.data();
+    std::size_t left = buffer.size();
+    while (left > 0) {
+        ssize_t n = ::write(fd, data, left);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Error writing file: " + filename);
+        }
+        data += n;
+        left -= static_cast<std::size_t>(n);
+    }
+    buffer.clear();
+}
+
+void MaterialDatabaseWriter::close() {
+    if (fd < 0) return;
+    flush();
+
+    MaterialDatabaseHeader header{};
+    std::memcpy(header.magic, material_database_magic, sizeof(header.magic));
+    header.version = material_database_version;
+    header.record_size = static_cast<std::uint32_t>(material_record_size);
+    header.record_count = count;
+    bool ok = ::pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    ::close(fd);
+    fd = -1;
+    if (!ok) {
+        throw std::runtime_error("Error writing file: " + filename);
+    }
+}
+
+MaterialDatabase::MaterialDatabase(std::string const& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Error opening file: " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(MaterialDatabaseHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not a material database: " + filename);
+    }
+    mapping_size = static_cast<std::size_t>(st.st_size);
+    mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the file open
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error("Error mapping file: " + filename);
+    }
+
+    MaterialDatabaseHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    if (std::memcmp(header.magic, material_database_magic, sizeof(header.magic)) != 0) {
+        unmap();
+        throw std::runtime_error("Not a material database: " + filename);
+    }
+    /* Later versions only append fields, which the record_size stride skips;
+     * a smaller record is a layout this reader cannot read.
+     */
+    if (header.version < 1 || header.record_size < material_record_size) {
+        unmap();
+        throw std::runtime_error("Unsupported material database version in: " + filename);
+    }
+    if (header.record_count > (mapping_size - sizeof(header)) / header.record_size) {
+        unmap();
+        throw std::runtime_error("Truncated material database: " + filename);
+    }
+
+    records = static_cast<char const*>(mapping) + sizeof(header);
+    record_size = header.record_size;
+    record_count = static_cast<std::size_t>(header.record_count);
+    // records are mostly scanned front to back
+    ::madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+}
+
+MaterialDatabase::~MaterialDatabase() {
+    unmap();
+}
+
+MaterialDatabase::MaterialDatabase(MaterialDatabase&& that) noexcept :
+    mapping{std::exchange(that.mapping, nullptr)}, mapping_size{std::exchange(that.mapping_size, 0)},
+    records{std::exchange(that.records, nullptr)}, record_size{std::exchange(that.record_size, 0)},
+    record_count{std::exchange(that.record_count, 0)} {}
+
+MaterialDatabase& MaterialDatabase::operator=(MaterialDatabase&& that) noexcept {
+    if (this != &that) {
+        unmap();
+        mapping = std::exchange(that.mapping, nullptr);
+        mapping_size = std::exchange(that.mapping_size, 0);
+        records = std::exchange(that.records, nullptr);
+        record_size = std::exchange(that.record_size, 0);
+        record_count = std::exchange(that.record_count, 0);
+    }
+    return *this;
+}
+
+void MaterialDatabase::unmap() noexcept {
+    if (mapping) ::munmap(mapping, mapping_size);
+    mapping = nullptr;
+    records = nullptr;
+    record_count = 0;
+}
@@ -0,0 +1,86 @@
+#include "unitcell_kernels.H"
+
+#include <immintrin.h>
+
+std::int64_t sumUnitcellsScalar(int const* unitcells, std::size_t n) {
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        sum += unitcells[i];
+    }
+    return sum;
+}
+
+__attribute__((target("avx2")))
+std::int64_t sumUnitcellsAVX2(int const* unitcells, std::size_t n) {
+    // widen to 64 bits before adding, so no partial sum can overflow
+    __m256i sum0 = _mm256_setzero_si256();
+    __m256i sum1 = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(unitcells + i));
+        sum0 = _mm256_add_epi64(sum0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        sum1 = _mm256_add_epi64(sum1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(sum0, sum1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumUnitcellsScalar(unitcells + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+std::int64_t sumUnitcellsAVX512(int const* unitcells, std::size_t n) {
+    __m512i sum0 = _mm512_setzero_si512();
+    __m512i sum1 = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i v = _mm512_loadu_si512(unitcells + i);
+        sum0 = _mm512_add_epi64(sum0, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v)));
+        sum1 = _mm512_add_epi64(sum1, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1)));
+    }
+    // the tail with a masked load instead of a scalar loop
+    if (i < n) {
+        __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+        __m512i v = _mm512_maskz_loadu_epi32(mask, unitcells + i);
+        sum0 = _mm512_add_epi64(sum0, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v)));
+        sum1 = _mm512_add_epi64(sum1, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1)));
+    }
+    return _mm512_reduce_add_epi64(_mm512_add_epi64(sum0, sum1));
+}
+
+bool unitcellKernelSupported(UnitcellKernel kernel) {
+    switch (kernel) {
+        case UnitcellKernel::Scalar: return true;
+        case UnitcellKernel::AVX2:   return __builtin_cpu_supports("avx2");
+        case UnitcellKernel::AVX512: return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+}
+
+UnitcellKernel unitcellKernel() {
+    static const UnitcellKernel kernel = [] {
+        if (unitcellKernelSupported(UnitcellKernel::AVX512)) return UnitcellKernel::AVX512;
+        if (unitcellKernelSupported(UnitcellKernel::AVX2)) return UnitcellKernel::AVX2;
+        return UnitcellKernel::Scalar;
+    }();
+    return kernel;
+}
+
+char const* toString(UnitcellKernel kernel) {
+    switch (kernel) {
+        case UnitcellKernel::Scalar: return "scalar";
+        case UnitcellKernel::AVX2:   return "AVX2";
+        case UnitcellKernel::AVX512: return "AVX-512";
+    }
+    return "unknown";
+}
+
+std::int64_t sumUnitcells(int const* unitcells, std::size_t n) {
+    using Kernel = std::int64_t (*)(int const*, std::size_t);
+    static const Kernel kernel = [] {
+        switch (unitcellKernel()) {
+            case UnitcellKernel::AVX512: return &sumUnitcellsAVX512;
+            case UnitcellKernel::AVX2:   return &sumUnitcellsAVX2;
+            default:                     return &sumUnitcellsScalar;
+        }
+    }();
+    return kernel(unitcells, n);
+}
@@ -0,0 +1,113 @@
+#include "work_stealing_pool.H"
+
+#include <pthread.h>
+#include <sched.h>
+
+std::vector<int> WorkStealingPool::available_cores() {
+    std::vector<int> cores;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cores.push_back(cpu);
+        }
+    }
+    if (cores.empty()) cores.push_back(0);
+    return cores;
+}
+
+WorkStealingPool::WorkStealingPool(std::size_t threads, bool pin_threads) {
+    std::vector<int> cores = available_cores();
+    if (threads == 0) threads = cores.size();
+
+    for (std::size_t i = 0; i < threads; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    try {
+        workers.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers.emplace_back(&WorkStealingPool::worker_loop, this, i);
+            if (pin_threads) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cores[i % cores.size()], &set);
+                // pinning is an optimization, a failure is not an error
+                pthread_setaffinity_np(workers.back().native_handle(), sizeof(set), &set);
+            }
+        }
+    }
+    catch (...) {
+        // e.g. std::system_error when no more threads can be created
+        shutdown();
+        throw;
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    shutdown();
+}
+
+void WorkStealingPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    job_ready.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void WorkStealingPool::run(std::function<void(std::size_t)> const& f) {
+    std::unique_lock<std::mutex> lock(mutex);
+    job = &f;
+    running = workers.size();
+    ++generation;
+    job_ready.notify_all();
+    job_done.wait(lock, [this] { return running == 0; });
+    job = nullptr;
+}
+
+void WorkStealingPool::worker_loop(std::size_t worker) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        std::function<void(std::size_t)> const* f;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            job_ready.wait(lock, [&] { return stop || generation != seen; });
+            if (stop) return;
+            seen = generation;
+            f = job;
+        }
+
+        (*f)(worker);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--running == 0) job_done.notify_one();
+    }
+}
+
+void WorkStealingPool::push(std::size_t worker, Range range) {
+    Queue& queue = *queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.ranges.push_back(range);
+}
+
+bool WorkStealingPool::pop(std::size_t worker, Range& range) {
+    Queue& queue = *queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.ranges.empty()) return false;
+    range = queue.ranges.back();
+    queue.ranges.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(std::size_t worker, Range& range) {
+    for (std::size_t k = 1; k < queues.size(); ++k) {
+        Queue& queue = *queues[(worker + k) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.ranges.empty()) continue;
+        range = queue.ranges.front();
+        queue.ranges.pop_front();
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,91 @@
+/* Snapshots of a material set between simulation steps: copying a
+ * std::vector<Algorithm> with one heap allocation per model vs copying into
+ * a std::pmr::vector<Algorithm> whose models all go into one
+ * monotonic_buffer_resource. Reports the copy and release time per element,
+ * the number of calls into the upstream allocator and the peak RSS.
+ * Each variant runs in a child process of its own, so that the peak RSS of
+ * one does not hide the other's.
+ *
+ * usage: bench_arena [materials] [snapshots]   (default 10^7, 5)
+ */
+
+#include "bench_materials.H"
+#include "../algorithm_impl/algorithm.H"
+
+#include <memory_resource>
+
+namespace {
+
+// counts the calls that reach the heap
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t calls = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++calls;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        ++calls;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(std::pmr::memory_resource const& that) const noexcept override {
+        return this == &that;
+    }
+};
+
+void heap_snapshots(std::size_t n, std::size_t snapshots)
+{
+    CountingResource counting;
+    std::pmr::set_default_resource(&counting);
+
+    auto materials = make_materials<std::vector<Algorithm>>(n);
+    double copy = 0.0, release = 0.0;
+    std::size_t calls_before = counting.calls;
+
+    for (std::size_t s = 0; s < snapshots; ++s) {
+        auto snapshot = std::make_unique<std::vector<Algorithm>>();
+        copy += ns_per_element(n, [&] { *snapshot = materials; });
+        computeAlgorithm(*snapshot);
+        release += ns_per_element(n, [&] { snapshot.reset(); });
+    }
+
+    report("heap", "copy", copy / snapshots);
+    report("heap", "release", release / snapshots);
+    std::cout << std::left << std::setw(28) << "heap" << std::setw(16) << "allocator calls" << std::right
+              << std::setw(10) << (counting.calls - calls_before) / snapshots << " per snapshot\n";
+    std::pmr::set_default_resource(nullptr);
+}
+
+void arena_snapshots(std::size_t n, std::size_t snapshots)
+{
+    auto materials = make_materials<std::vector<Algorithm>>(n);
+    double copy = 0.0, release = 0.0;
+    CountingResource counting;
+
+    for (std::size_t s = 0; s < snapshots; ++s) {
+        std::pmr::monotonic_buffer_resource arena(&counting);
+        auto snapshot = std::make_unique<std::pmr::vector<Algorithm>>(&arena);
+        copy += ns_per_element(n, [&] { snapshot->assign(materials.begin(), materials.end()); });
+        computeAlgorithm(*snapshot);
+        release += ns_per_element(n, [&] { snapshot.reset(); arena.release(); });
+    }
+
+    report("arena", "copy", copy / snapshots);
+    report("arena", "release", release / snapshots);
+    std::cout << std::left << std::setw(28) << "arena" << std::setw(16) << "allocator calls" << std::right
+              << std::setw(10) << counting.calls / snapshots << " per snapshot\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t snapshots = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5;
+    if (snapshots == 0) snapshots = 1;
+
+    run_in_child("heap", [&] { heap_snapshots(n, snapshots); });
+    run_in_child("arena", [&] { arena_snapshots(n, snapshots); });
+}
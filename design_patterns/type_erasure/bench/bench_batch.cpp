@@ -0,0 +1,79 @@
+/* Batch affordances computeStep1(std::span<const T>):
+ * - the unit-cell kernels (scalar, AVX2, AVX-512) on their own,
+ * - MaterialCollection with one batch call per type vs a loop of
+ *   single-material calls,
+ * - std::vector<Algorithm> with materials grouped by type, where
+ *   computeAlgorithm finds runs and batches them, vs alternating types, where
+ *   every run has length 1, vs a loop of single-material calls.
+ * All in ns/element.
+ *
+ * usage: bench_batch [materials]   (default 10^7)
+ */
+
+#include "bench_materials.H"
+#include "../algorithm_impl/algorithm.H"
+#include "../algorithm_impl/material_collection.H"
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    static_assert(BatchStep1<BenchCNT> && BatchStep1<BenchGraphene>);
+
+    std::cout << "kernel picked via CPUID: " << toString(unitcellKernel()) << "\n\n";
+
+    std::vector<int> unitcells(n);
+    for (std::size_t i = 0; i < n; ++i) unitcells[i] = static_cast<int>(i % 16) + 1;
+
+    using Kernel = std::int64_t (*)(int const*, std::size_t);
+    std::pair<UnitcellKernel, Kernel> kernels[] = {
+        {UnitcellKernel::Scalar, &sumUnitcellsScalar},
+        {UnitcellKernel::AVX2, &sumUnitcellsAVX2},
+        {UnitcellKernel::AVX512, &sumUnitcellsAVX512},
+    };
+    for (auto [kernel, sum] : kernels) {
+        if (!unitcellKernelSupported(kernel)) continue;
+        std::int64_t result = sum(unitcells.data(), n);
+        report("sumUnitcells", toString(kernel), ns_per_element(n, [&] { result = sum(unitcells.data(), n); }));
+        bench_unitcells += result;
+    }
+    std::cout << "\n";
+
+    {
+        MaterialCollection<BenchCNT, BenchGraphene> collection;
+        collection.reserve(n / 2 + 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            int uc = static_cast<int>(i % 16) + 1;
+            if (i % 2 == 0) collection.emplace_back(BenchCNT{uc});
+            else collection.emplace_back(BenchGraphene{uc});
+        }
+        report("MaterialCollection", "batch", ns_per_element(n, [&] { computeAlgorithm(collection); }));
+        report("MaterialCollection", "single", ns_per_element(n, [&] {
+            collection.for_each_type([](auto const& partition) {
+                for (auto const& material : partition) computeStep1(material);
+            });
+        }));
+        std::cout << "\n";
+    }
+
+    {
+        std::vector<Algorithm> grouped;
+        grouped.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            int uc = static_cast<int>(i % 16) + 1;
+            if (i < n / 2) grouped.emplace_back(BenchCNT{uc});
+            else grouped.emplace_back(BenchGraphene{uc});
+        }
+        auto alternating = make_materials<std::vector<Algorithm>>(n);
+
+        report("Algorithm grouped", "runs", ns_per_element(n, [&] { computeAlgorithm(grouped); }));
+        report("Algorithm grouped", "single", ns_per_element(n, [&] {
+            for (auto const& material : grouped) computeStep1(material);
+        }));
+        report("Algorithm alternating", "runs", ns_per_element(n, [&] { computeAlgorithm(alternating); }));
+        report("Algorithm alternating", "single", ns_per_element(n, [&] {
+            for (auto const& material : alternating) computeStep1(material);
+        }));
+    }
+
+    std::cout << "\nunit cells processed: " << bench_unitcells << "\n";
+}
@@ -0,0 +1,55 @@
+/* Algorithm (open set, virtual call) vs AlgorithmClosed (closed set,
+ * std::variant): computeAlgorithm over alternating and over randomly mixed
+ * CNT and Graphene, and the cost to build and copy the vector, in ns/element.
+ *
+ * usage: bench_closed [materials]   (default 10^7)
+ */
+
+#include "bench_materials.H"
+#include "../algorithm_impl/algorithm.H"
+#include "../algorithm_impl/algorithm_closed.H"
+
+#include <random>
+
+namespace {
+
+template <typename Materials>
+void run(const char* name, std::size_t n)
+{
+    Materials materials;
+    report(name, "build", ns_per_element(n, [&] { materials = make_materials<Materials>(n); }));
+
+    computeAlgorithm(materials);
+    report(name, "alternating", ns_per_element(n, [&] { computeAlgorithm(materials); }));
+
+    Materials mixed;
+    mixed.reserve(n);
+    std::mt19937 rng(42);
+    std::bernoulli_distribution is_cnt(0.5);
+    for (std::size_t i = 0; i < n; ++i) {
+        int uc = static_cast<int>(i % 16) + 1;
+        if (is_cnt(rng)) mixed.emplace_back(BenchCNT{uc});
+        else mixed.emplace_back(BenchGraphene{uc});
+    }
+    computeAlgorithm(mixed);
+    report(name, "random mix", ns_per_element(n, [&] { computeAlgorithm(mixed); }));
+
+    report(name, "copy", ns_per_element(n, [&] { Materials copy = materials; }));
+    std::cout << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    using Closed = AlgorithmClosed<BenchCNT, BenchGraphene>;
+    std::cout << "sizeof(Algorithm) = " << sizeof(Algorithm)
+              << ", sizeof(AlgorithmClosed<BenchCNT, BenchGraphene>) = " << sizeof(Closed) << "\n\n";
+
+    run<std::vector<Algorithm>>("Algorithm", n);
+    run<std::vector<Closed>>("AlgorithmClosed", n);
+
+    std::cout << "unit cells processed: " << bench_unitcells << "\n";
+}
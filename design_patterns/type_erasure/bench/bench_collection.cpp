@@ -0,0 +1,68 @@
+/* std::vector<Algorithm> vs MaterialCollection<BenchCNT, BenchGraphene>:
+ * computeAlgorithm over a randomly mixed batch of CNT and Graphene, in
+ * ns/element, plus the cost of removing every other material by handle.
+ *
+ * usage: bench_collection [materials]   (default 10^7)
+ */
+
+#include "bench_materials.H"
+#include "../algorithm_impl/algorithm.H"
+#include "../algorithm_impl/algorithm_sbo.H"
+#include "../algorithm_impl/material_collection.H"
+
+#include <random>
+
+namespace {
+
+using Collection = MaterialCollection<BenchCNT, BenchGraphene>;
+
+// same random sequence of materials for every container
+template <typename F>
+void generate_mixed(std::size_t n, F&& add)
+{
+    std::mt19937 rng(42);
+    std::bernoulli_distribution is_cnt(0.5);
+    for (std::size_t i = 0; i < n; ++i) {
+        int uc = static_cast<int>(i % 16) + 1;
+        if (is_cnt(rng)) add(BenchCNT{uc});
+        else add(BenchGraphene{uc});
+    }
+}
+
+template <typename Materials>
+void run_erased(const char* name, std::size_t n)
+{
+    Materials materials;
+    materials.reserve(n);
+    generate_mixed(n, [&](auto&& m) { materials.emplace_back(std::move(m)); });
+
+    computeAlgorithm(materials);
+    report(name, "computeAlgorithm", ns_per_element(n, [&] { computeAlgorithm(materials); }));
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    run_erased<std::vector<Algorithm>>("Algorithm", n);
+    run_erased<std::vector<AlgorithmSBO<32>>>("AlgorithmSBO<32>", n);
+
+    Collection collection;
+    std::vector<Collection::Handle> handles;
+    handles.reserve(n);
+    report("MaterialCollection", "emplace_back", ns_per_element(n, [&] {
+        generate_mixed(n, [&](auto&& m) { handles.push_back(collection.emplace_back(std::move(m))); });
+    }));
+
+    computeAlgorithm(collection);
+    report("MaterialCollection", "computeAlgorithm", ns_per_element(n, [&] { computeAlgorithm(collection); }));
+
+    report("MaterialCollection", "remove (half)", ns_per_element(n / 2, [&] {
+        for (std::size_t i = 0; i < n; i += 2) collection.remove(handles[i]);
+    }));
+    report("MaterialCollection", "computeAlgorithm", ns_per_element(n / 2, [&] { computeAlgorithm(collection); }));
+
+    std::cout << "\nunit cells processed: " << bench_unitcells << "\n";
+}
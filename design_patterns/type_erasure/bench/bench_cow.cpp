@@ -0,0 +1,45 @@
+/* Snapshot cost: copying a std::vector<Algorithm> (a clone per element) vs a
+ * std::vector<AlgorithmCOW> (a reference count increment per element) vs a
+ * MaterialsCOW (one increment for the whole vector), in ns/element, and the
+ * price of the first update after a snapshot, when the models are cloned.
+ *
+ * usage: bench_cow [materials]   (default 10^7)
+ */
+
+#include "bench_materials.H"
+#include "../algorithm_impl/algorithm.H"
+#include "../algorithm_impl/algorithm_cow.H"
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    {
+        auto materials = make_materials<std::vector<Algorithm>>(n);
+        std::vector<Algorithm> snapshot;
+        report("Algorithm", "snapshot", ns_per_element(n, [&] { snapshot = materials; }));
+    }
+
+    {
+        auto materials = make_materials<std::vector<AlgorithmCOW>>(n);
+        std::vector<AlgorithmCOW> snapshot;
+        report("AlgorithmCOW", "snapshot", ns_per_element(n, [&] { snapshot = materials; }));
+        report("AlgorithmCOW", "update (shared)", ns_per_element(n, [&] { updateAlgorithm(materials); }));
+        report("AlgorithmCOW", "update (owned)", ns_per_element(n, [&] { updateAlgorithm(materials); }));
+        report("AlgorithmCOW", "computeAlgorithm", ns_per_element(n, [&] { computeAlgorithm(snapshot); }));
+    }
+
+    {
+        MaterialsCOW materials;
+        materials.reserve(n);
+        for (auto& material : make_materials<std::vector<AlgorithmCOW>>(n)) {
+            materials.emplace_back(std::move(material));
+        }
+        MaterialsCOW snapshot;
+        report("MaterialsCOW", "snapshot", ns_per_element(n, [&] { snapshot = materials; }));
+        report("MaterialsCOW", "update (shared)", ns_per_element(n, [&] { updateAlgorithm(materials); }));
+        report("MaterialsCOW", "update (owned)", ns_per_element(n, [&] { updateAlgorithm(materials); }));
+    }
+
+    std::cout << "\nunit cells processed: " << bench_unitcells << "\n";
+}
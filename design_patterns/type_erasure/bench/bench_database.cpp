@@ -0,0 +1,111 @@
+/* Startup cost of loading materials: parsing a text file into a
+ * std::vector<Algorithm> vs opening a MaterialDatabase, and then touching
+ * the first 1000 materials and all of them. The file's pages are dropped
+ * from the page cache (where permitted) before every load.
+ *
+ * usage: bench_database [materials] [directory]   (default 10^7, .)
+ */
+
+#include "bench_materials.H"
+#include "../algorithm_impl/material_database.H"
+#include "../algorithm_impl/algorithm.H"
+
+#include <fstream>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+double ms(auto&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void report_ms(const char* name, const char* what, double t)
+{
+    std::cout << std::left << std::setw(28) << name << std::setw(24) << what << std::right
+              << std::fixed << std::setw(10) << std::setprecision(2) << t << " ms\n";
+}
+
+void drop_page_cache(std::string const& filename)
+{
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    ::fdatasync(fd);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::string directory = argc > 2 ? argv[2] : ".";
+    std::string text_file = directory + "/bench_database.txt";
+    std::string database_file = directory + "/bench_database.matdb";
+    const std::size_t touched = std::min<std::size_t>(1000, n);
+
+    report_ms("text", "write", ms([&] {
+        std::ofstream out(text_file);
+        for (std::size_t i = 0; i < n; ++i) {
+            out << (i % 2 == 0 ? "CNT " : "Graphene ") << (i % 16) + 1 << "\n";
+        }
+    }));
+    report_ms("MaterialDatabase", "write", ms([&] {
+        MaterialDatabaseWriter writer(database_file);
+        for (std::size_t i = 0; i < n; ++i) {
+            int uc = static_cast<int>(i % 16) + 1;
+            if (i % 2 == 0) writer.append(CNT{uc});
+            else writer.append(Graphene{uc});
+        }
+    }));
+    std::cout << "\n";
+
+    {
+        drop_page_cache(text_file);
+        std::vector<Algorithm> materials;
+        report_ms("text", "open (parse all)", ms([&] {
+            std::ifstream in(text_file);
+            std::string type;
+            int uc;
+            while (in >> type >> uc) {
+                if (type == "CNT") materials.emplace_back(BenchCNT{uc});
+                else materials.emplace_back(BenchGraphene{uc});
+            }
+        }));
+        report_ms("text", "touch first 1000", ms([&] {
+            for (std::size_t i = 0; i < touched; ++i) computeStep1(materials[i]);
+        }));
+        report_ms("text", "touch all", ms([&] { computeAlgorithm(materials); }));
+    }
+    std::cout << "\n";
+
+    {
+        drop_page_cache(database_file);
+        std::int64_t sum = 0;
+        auto touch = [&](MaterialRecordView view) {
+            view.visit([&](auto const& material) { sum += material.get_unitcells(); });
+        };
+
+        std::unique_ptr<MaterialDatabase> database;
+        report_ms("MaterialDatabase", "open (mmap)", ms([&] {
+            database = std::make_unique<MaterialDatabase>(database_file);
+        }));
+        report_ms("MaterialDatabase", "touch first 1000", ms([&] {
+            for (std::size_t i = 0; i < touched; ++i) touch((*database)[i]);
+        }));
+        report_ms("MaterialDatabase", "touch all", ms([&] {
+            for (std::size_t i = 0; i < database->size(); ++i) touch((*database)[i]);
+        }));
+        bench_unitcells += sum;
+    }
+
+    std::cout << "\nunit cells processed: " << bench_unitcells << "\n";
+    std::remove(text_file.c_str());
+    std::remove(database_file.c_str());
+}
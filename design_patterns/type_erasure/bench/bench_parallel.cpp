@@ -0,0 +1,81 @@
+/* Strong scaling of computeAlgorithmParallel: a fixed set of materials whose
+ * computeStep1 costs time proportional to the unit cells, with a few very
+ * large materials among many small ones, run on 1, 2, 4, ... up to all cores.
+ * Reports the time, the speedup over computeAlgorithm and the efficiency.
+ *
+ * usage: bench_parallel [materials]   (default 10^6)
+ */
+
+#include "bench_materials.H"
+
+#include <cmath>
+#include <random>
+
+// materials with real work in computeStep1; declared before the algorithm headers
+class HeavyCNT : public CNT {
+public:
+    using CNT::CNT;
+};
+
+class HeavyGraphene : public Graphene {
+public:
+    using Graphene::Graphene;
+};
+
+inline double heavy_work(int unitcells) {
+    double x = 0.0;
+    for (int i = 0; i < unitcells * 32; ++i) x += std::sqrt(static_cast<double>(i));
+    return x;
+}
+
+inline thread_local double heavy_sink = 0.0;
+
+inline void computeStep1(HeavyCNT const& cnt) { heavy_sink += heavy_work(cnt.get_unitcells()); }
+inline void computeStep1(HeavyGraphene const& graphene) { heavy_sink += heavy_work(graphene.get_unitcells()); }
+
+inline std::size_t costHint(HeavyCNT const& cnt) { return static_cast<std::size_t>(cnt.get_unitcells()); }
+inline std::size_t costHint(HeavyGraphene const& graphene) { return static_cast<std::size_t>(graphene.get_unitcells()); }
+
+#include "../algorithm_impl/algorithm.H"
+#include "../algorithm_impl/algorithm_parallel.H"
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    // 1..16 unit cells, but one material in 1000 has 1000 of them
+    std::vector<Algorithm> materials;
+    materials.reserve(n);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> small(1, 16);
+    std::uniform_int_distribution<int> rare(0, 999);
+    for (std::size_t i = 0; i < n; ++i) {
+        int uc = rare(rng) == 0 ? 1000 : small(rng);
+        if (i % 2 == 0) materials.emplace_back(HeavyCNT{uc});
+        else materials.emplace_back(HeavyGraphene{uc});
+    }
+
+    auto ms = [](auto&& f) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    double serial = ms([&] { computeAlgorithm(materials); });
+    std::cout << std::left << std::setw(10) << "threads" << std::right << std::setw(12) << "ms"
+              << std::setw(12) << "speedup" << std::setw(14) << "efficiency\n";
+    std::cout << std::left << std::setw(10) << "serial" << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << serial << "\n";
+
+    std::size_t cores = WorkStealingPool::available_cores().size();
+    for (std::size_t threads = 1; ; threads = std::min(threads * 2, cores)) {
+        WorkStealingPool pool(threads);
+        computeAlgorithmParallel(materials, pool); // warm up
+        double t = ms([&] { computeAlgorithmParallel(materials, pool); });
+        std::cout << std::left << std::setw(10) << threads << std::right << std::setw(12) << t
+                  << std::setw(12) << serial / t
+                  << std::setw(13) << 100.0 * serial / t / static_cast<double>(threads) << "%\n";
+        if (threads == cores) break;
+    }
+}
@@ -0,0 +1,33 @@
+/* AlgorithmPipeline<Step1, Step2, Step3>: material by material
+ * (computeAlgorithm) vs stage by stage over batches (computeAlgorithmBatched)
+ * vs batches overlapped across one thread per stage
+ * (computeAlgorithmPipelined), in ns/element, for several batch sizes.
+ *
+ * usage: bench_pipeline [materials]   (default 10^7)
+ */
+
+#include "bench_materials.H"
+#include "../algorithm_impl/algorithm_pipeline.H"
+
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    using Materials = std::vector<AlgorithmPipeline<Step1, Step2, Step3>>;
+    auto materials = make_materials<Materials>(n);
+
+    computeAlgorithm(materials);
+    report("computeAlgorithm", "", ns_per_element(n, [&] { computeAlgorithm(materials); }));
+
+    for (std::size_t batch_size : {256, 4096, 65536}) {
+        std::string batch = "batch " + std::to_string(batch_size);
+        report("computeAlgorithmBatched", batch.c_str(),
+               ns_per_element(n, [&] { computeAlgorithmBatched(materials, batch_size); }));
+        report("computeAlgorithmPipelined", batch.c_str(),
+               ns_per_element(n, [&] { computeAlgorithmPipelined(materials, batch_size); }));
+    }
+
+    std::cout << "\nunit cells processed: " << bench_unitcells << "\n";
+}
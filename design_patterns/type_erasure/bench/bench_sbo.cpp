@@ -0,0 +1,60 @@
+/* Algorithm (pimpl) vs AlgorithmSBO: time to build, run computeAlgorithm over
+ * and copy a vector of alternating CNT and Graphene, in ns/element, and the
+ * number of heap allocations per element.
+ *
+ * usage: bench_sbo [materials]   (default 10^7)
+ */
+
+#include "bench_materials.H"
+#include "../algorithm_impl/algorithm.H"
+#include "../algorithm_impl/algorithm_sbo.H"
+
+#include <atomic>
+#include <new>
+
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+
+template <typename Materials>
+void run(const char* name, std::size_t n)
+{
+    Materials materials;
+    std::size_t before = allocations.load();
+    report(name, "build", ns_per_element(n, [&] { materials = make_materials<Materials>(n); }));
+    double allocs = static_cast<double>(allocations.load() - before) / static_cast<double>(n);
+
+    computeAlgorithm(materials); // warm up
+    report(name, "computeAlgorithm", ns_per_element(n, [&] { computeAlgorithm(materials); }));
+    report(name, "copy", ns_per_element(n, [&] { Materials copy = materials; }));
+
+    std::cout << std::left << std::setw(24) << name << std::setw(16) << "allocations" << std::right
+              << std::setw(10) << std::setprecision(2) << allocs << " per element\n\n";
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::cout << "sizeof(Algorithm) = " << sizeof(Algorithm)
+              << ", sizeof(AlgorithmSBO<32>) = " << sizeof(AlgorithmSBO<32>)
+              << ", sizeof(AlgorithmSBO<64>) = " << sizeof(AlgorithmSBO<64>) << "\n\n";
+
+    run<std::vector<Algorithm>>("Algorithm", n);
+    run<std::vector<AlgorithmSBO<32>>>("AlgorithmSBO<32>", n);
+    run<std::vector<AlgorithmSBO<64>>>("AlgorithmSBO<64>", n);
+
+    std::cout << "unit cells processed: " << bench_unitcells << "\n";
+}
@@ -0,0 +1,85 @@
+/* Loading all materials before computeAlgorithm vs computeAlgorithmStream,
+ * which overlaps reading the next batch with computing the current one:
+ * time per material and peak RSS, for a text file and for a generator that
+ * produces ten times as many materials.
+ *
+ * usage: bench_stream [materials] [batch size] [directory]   (default 10^7, 4096, .)
+ */
+
+#include "bench_materials.H"
+#include "../algorithm_impl/algorithm_stream.H"
+
+#include <fstream>
+#include <string>
+
+namespace {
+
+bool makeBenchMaterial(std::pmr::vector<Algorithm>& batch, std::string_view type, int unitcells)
+{
+    if (type == "CNT") batch.emplace_back(BenchCNT{unitcells});
+    else if (type == "Graphene") batch.emplace_back(BenchGraphene{unitcells});
+    else return false;
+    return true;
+}
+
+auto benchGenerator(std::size_t n)
+{
+    return [n, i = std::size_t(0)]() mutable -> std::optional<BenchCNT> {
+        if (i == n) return std::nullopt;
+        return BenchCNT{static_cast<int>(i++ % 16) + 1};
+    };
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t batch_size = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4096;
+    std::string text_file = (argc > 3 ? std::string(argv[3]) : std::string(".")) + "/bench_stream.txt";
+
+    {
+        std::ofstream out(text_file);
+        for (std::size_t i = 0; i < n; ++i) {
+            out << (i % 2 == 0 ? "CNT " : "Graphene ") << (i % 16) + 1 << "\n";
+        }
+    }
+
+    run_in_child("text, load all", [&] {
+        report("text, load all", "", ns_per_element(n, [&] {
+            std::pmr::vector<Algorithm> materials;
+            TextFileSource source(text_file, makeBenchMaterial);
+            while (source(materials, batch_size) != 0) {}
+            computeAlgorithm(materials);
+        }));
+    });
+
+    run_in_child("text, stream", [&] {
+        report("text, stream", "", ns_per_element(n, [&] {
+            computeAlgorithmStream(TextFileSource(text_file, makeBenchMaterial), batch_size);
+        }));
+    });
+
+    run_in_child("generator, load all", [&] {
+        report("generator, load all", "", ns_per_element(n, [&] {
+            std::pmr::vector<Algorithm> materials;
+            auto source = generatorSource(benchGenerator(n));
+            while (source(materials, batch_size) != 0) {}
+            computeAlgorithm(materials);
+        }));
+    });
+
+    run_in_child("generator, stream", [&] {
+        report("generator, stream", "", ns_per_element(n, [&] {
+            computeAlgorithmStream(generatorSource(benchGenerator(n)), batch_size);
+        }));
+    });
+
+    run_in_child("generator x10, stream", [&] {
+        report("generator x10, stream", "", ns_per_element(10 * n, [&] {
+            computeAlgorithmStream(generatorSource(benchGenerator(10 * n)), batch_size);
+        }));
+    });
+
+    std::remove(text_file.c_str());
+}
@@ -0,0 +1,49 @@
+/* Dispatch cost of the type erasure backends: computeAlgorithm over a vector
+ * of alternating CNT and Graphene, in ns/element, once for a vector that fits
+ * into the L1 cache (repeated) and once for 10^7 materials. Copy cost is
+ * reported for the large vector.
+ *
+ * usage: bench_vtable [materials] [repetitions of the small vector]
+ */
+
+#include "bench_materials.H"
+#include "../algorithm_impl/algorithm.H"
+#include "../algorithm_impl/algorithm_sbo.H"
+#include "../algorithm_impl/algorithm_vtable.H"
+
+namespace {
+
+template <typename Materials>
+void run(const char* name, std::size_t n, std::size_t repetitions)
+{
+    constexpr std::size_t small = 512;
+    auto hot = make_materials<Materials>(small);
+    computeAlgorithm(hot);
+    report(name, "dispatch (L1)", ns_per_element(small * repetitions, [&] {
+        for (std::size_t r = 0; r < repetitions; ++r) computeAlgorithm(hot);
+    }));
+
+    auto materials = make_materials<Materials>(n);
+    computeAlgorithm(materials);
+    report(name, "dispatch", ns_per_element(n, [&] { computeAlgorithm(materials); }));
+    report(name, "copy", ns_per_element(n, [&] { Materials copy = materials; }));
+    std::cout << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t repetitions = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+
+    std::cout << "sizeof(Algorithm) = " << sizeof(Algorithm)
+              << ", sizeof(AlgorithmSBO<32>) = " << sizeof(AlgorithmSBO<32>)
+              << ", sizeof(AlgorithmVtable<24>) = " << sizeof(AlgorithmVtable<24>) << "\n\n";
+
+    run<std::vector<Algorithm>>("Algorithm (virtual)", n, repetitions);
+    run<std::vector<AlgorithmSBO<32>>>("AlgorithmSBO<32>", n, repetitions);
+    run<std::vector<AlgorithmVtable<24>>>("AlgorithmVtable<24>", n, repetitions);
+
+    std::cout << "unit cells processed: " << bench_unitcells << "\n";
+}
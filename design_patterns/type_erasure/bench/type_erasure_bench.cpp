@@ -0,0 +1,372 @@
+/* type_erasure_bench: reproducible microbenchmarks of every type-erased
+ * material wrapper, written as JSON so that runs can be compared between
+ * releases.
+ *
+ * For Algorithm, AlgorithmSBO<32>, AlgorithmVtable<24> and
+ * AlgorithmClosed<BenchCNT, BenchGraphene> it measures
+ *     build             emplace_back of n materials into a reserved vector
+ *     copy              copy construction of n materials
+ *     move              move construction of n materials
+ *     computeStep1      a loop calling computeStep1 on every material
+ *     computeAlgorithm  the wrapper's own computeAlgorithm
+ * for 10^min_exp ... 10^max_exp materials and every CNT fraction given with
+ * --mix. The materials are placed in a random order (fixed seed), so a mix
+ * of 0.5 defeats the branch predictor and 1.0 does not.
+ *
+ * Every result holds the min and median time in ns/element over the samples,
+ * and per element the heap allocations, and, where perf_event_open is
+ * permitted, the last-level cache misses and L1 data cache read misses
+ * (null otherwise). Only the timed part of an operation is counted; the
+ * vectors are reserved and cleared outside of it.
+ *
+ * usage: type_erasure_bench [--min-exp E] [--max-exp E] [--mix r,r,...]
+ *                           [--samples S] [--out file.json]
+ *        (default 10^3 ... 10^7, mix 0.5,0.9,1, samples chosen per size,
+ *         JSON on stdout; 10^8 needs about 5 GiB for Algorithm)
+ */
+
+#include "bench_materials.H"
+#include "../algorithm_impl/algorithm.H"
+#include "../algorithm_impl/algorithm_sbo.H"
+#include "../algorithm_impl/algorithm_vtable.H"
+#include "../algorithm_impl/algorithm_closed.H"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <new>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+
+#ifndef TYPE_ERASURE_BENCH_BUILD_TYPE
+#define TYPE_ERASURE_BENCH_BUILD_TYPE ""
+#endif
+
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+
+/* One hardware counter of the calling thread, in user space only.
+ * available() is false when the kernel or the sandbox does not permit it.
+ */
+class PerfCounter {
+public:
+    PerfCounter(std::uint32_t type, std::uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~PerfCounter() {
+        if (fd >= 0) close(fd);
+    }
+
+    PerfCounter(PerfCounter const&) = delete;
+    PerfCounter& operator=(PerfCounter const&) = delete;
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    std::uint64_t stop() {
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        std::uint64_t count = 0;
+        if (read(fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) return 0;
+        return count;
+    }
+
+private:
+    int fd = -1;
+};
+
+struct Counters {
+    PerfCounter cache_misses{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+    PerfCounter l1d_misses{PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                                               (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+};
+
+struct Options {
+    int min_exp = 3;
+    int max_exp = 7;
+    std::vector<double> mixes{0.5, 0.9, 1.0};
+    std::size_t samples = 0; // 0: chosen per size
+    std::string out;
+};
+
+struct Result {
+    std::string variant;
+    std::string operation;
+    std::size_t materials;
+    double cnt_fraction;
+    std::size_t samples;
+    double ns_min;
+    double ns_median;
+    double allocations;
+    std::optional<double> cache_misses;
+    std::optional<double> l1d_misses;
+};
+
+/* Runs setup() and then the timed body() once per sample; the counters and
+ * allocations are averaged over the samples and reported per element.
+ */
+template <typename Setup, typename Body>
+Result measure(Counters& counters, std::size_t n, std::size_t samples, Setup&& setup, Body&& body)
+{
+    std::vector<double> ns;
+    ns.reserve(samples);
+    std::uint64_t allocs = 0, cache_misses = 0, l1d_misses = 0;
+
+    for (std::size_t s = 0; s < samples; ++s) {
+        setup();
+        std::size_t before = allocations.load(std::memory_order_relaxed);
+        counters.cache_misses.start();
+        counters.l1d_misses.start();
+        ns.push_back(ns_per_element(n, body));
+        l1d_misses += counters.l1d_misses.stop();
+        cache_misses += counters.cache_misses.stop();
+        allocs += allocations.load(std::memory_order_relaxed) - before;
+    }
+
+    std::sort(ns.begin(), ns.end());
+    double per_element = static_cast<double>(n) * static_cast<double>(samples);
+
+    Result result{};
+    result.materials = n;
+    result.samples = samples;
+    result.ns_min = ns.front();
+    result.ns_median = ns[ns.size() / 2];
+    result.allocations = static_cast<double>(allocs) / per_element;
+    if (counters.cache_misses.available()) result.cache_misses = static_cast<double>(cache_misses) / per_element;
+    if (counters.l1d_misses.available()) result.l1d_misses = static_cast<double>(l1d_misses) / per_element;
+    return result;
+}
+
+// true for a CNT; a fraction `mix` of the n materials, in random order
+std::vector<bool> make_kinds(std::size_t n, double mix)
+{
+    std::vector<bool> kinds(n);
+    auto cnts = static_cast<std::size_t>(mix * static_cast<double>(n) + 0.5);
+    std::fill(kinds.begin(), kinds.begin() + static_cast<std::ptrdiff_t>(std::min(cnts, n)), true);
+    std::mt19937_64 rng(42);
+    std::shuffle(kinds.begin(), kinds.end(), rng);
+    return kinds;
+}
+
+template <typename Material>
+void emplace_materials(std::vector<Material>& materials, std::vector<bool> const& kinds)
+{
+    for (std::size_t i = 0; i < kinds.size(); ++i) {
+        int uc = static_cast<int>(i % 16) + 1;
+        if (kinds[i]) materials.emplace_back(BenchCNT{uc});
+        else materials.emplace_back(BenchGraphene{uc});
+    }
+}
+
+template <typename Material>
+void run(char const* name, Counters& counters, std::size_t n, double mix, std::size_t samples,
+         std::vector<Result>& results)
+{
+    auto kinds = make_kinds(n, mix);
+    std::vector<Material> materials, dst;
+    materials.reserve(n);
+    emplace_materials(materials, kinds);
+
+    auto record = [&](char const* operation, Result result) {
+        result.variant = name;
+        result.operation = operation;
+        result.cnt_fraction = mix;
+        results.push_back(std::move(result));
+    };
+
+    auto reserve_dst = [&] {
+        dst.clear();
+        dst.reserve(n);
+    };
+
+    record("build", measure(counters, n, samples, reserve_dst, [&] { emplace_materials(dst, kinds); }));
+
+    record("copy", measure(counters, n, samples, reserve_dst, [&] {
+        dst.insert(dst.end(), materials.begin(), materials.end());
+    }));
+
+    std::vector<Material> src;
+    record("move", measure(counters, n, samples, [&] {
+        reserve_dst();
+        src = materials;
+    }, [&] {
+        for (auto& material : src) dst.push_back(std::move(material));
+    }));
+    src.clear();
+    src.shrink_to_fit();
+    dst.clear();
+    dst.shrink_to_fit();
+
+    computeAlgorithm(materials); // warm up
+    record("computeStep1", measure(counters, n, samples, [] {}, [&] {
+        for (auto const& material : materials) computeStep1(material);
+    }));
+    record("computeAlgorithm", measure(counters, n, samples, [] {}, [&] { computeAlgorithm(materials); }));
+}
+
+std::vector<double> parse_mixes(std::string const& list)
+{
+    std::vector<double> mixes;
+    std::size_t pos = 0;
+    while (pos <= list.size()) {
+        std::size_t comma = list.find(',', pos);
+        if (comma == std::string::npos) comma = list.size();
+        double mix = std::stod(list.substr(pos, comma - pos));
+        if (mix < 0.0 || mix > 1.0) throw std::runtime_error("--mix: fractions must lie in [0, 1]");
+        mixes.push_back(mix);
+        pos = comma + 1;
+    }
+    return mixes;
+}
+
+Options parse_options(int argc, char* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) throw std::runtime_error("Missing value for " + arg);
+        std::string value = argv[++i];
+        if (arg == "--min-exp") options.min_exp = std::stoi(value);
+        else if (arg == "--max-exp") options.max_exp = std::stoi(value);
+        else if (arg == "--mix") options.mixes = parse_mixes(value);
+        else if (arg == "--samples") options.samples = std::stoull(value);
+        else if (arg == "--out") options.out = value;
+        else throw std::runtime_error("Unknown option: " + arg);
+    }
+    if (options.min_exp < 0 || options.max_exp > 9 || options.min_exp > options.max_exp) {
+        throw std::runtime_error("Material counts must satisfy 0 <= min-exp <= max-exp <= 9");
+    }
+    return options;
+}
+
+// enough samples for a stable median at small sizes, at least 3 at large ones
+std::size_t samples_for(Options const& options, std::size_t n)
+{
+    if (options.samples > 0) return options.samples;
+    return std::clamp<std::size_t>(10000000 / n, 3, 100);
+}
+
+void write_number(std::ostream& os, std::optional<double> value)
+{
+    if (value) os << *value;
+    else os << "null";
+}
+
+void write_json(std::ostream& os, Options const& options, bool perf_available,
+                std::vector<Result> const& results)
+{
+    os << std::setprecision(6) << std::defaultfloat;
+    os << "{\n";
+    os << "  \"benchmark\": \"type_erasure_bench\",\n";
+    os << "  \"unix_time\": " << std::time(nullptr) << ",\n";
+    os << "  \"compiler\": \"" << __VERSION__ << "\",\n";
+    os << "  \"build_type\": \"" << TYPE_ERASURE_BENCH_BUILD_TYPE << "\",\n";
+    os << "  \"unitcell_kernel\": \"" << toString(unitcellKernel()) << "\",\n";
+    os << "  \"perf_events\": " << (perf_available ? "true" : "false") << ",\n";
+    os << "  \"min_exp\": " << options.min_exp << ",\n";
+    os << "  \"max_exp\": " << options.max_exp << ",\n";
+    os << "  \"unit_cells_processed\": " << bench_unitcells << ",\n";
+    os << "  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        Result const& r = results[i];
+        os << (i ? ",\n" : "\n");
+        os << "    {\"variant\": \"" << r.variant << "\", \"operation\": \"" << r.operation
+           << "\", \"materials\": " << r.materials << ", \"cnt_fraction\": " << r.cnt_fraction
+           << ", \"samples\": " << r.samples
+           << ", \"ns_per_element\": {\"min\": " << r.ns_min << ", \"median\": " << r.ns_median << "}"
+           << ", \"allocations_per_element\": " << r.allocations
+           << ", \"cache_misses_per_element\": ";
+        write_number(os, r.cache_misses);
+        os << ", \"l1d_read_misses_per_element\": ";
+        write_number(os, r.l1d_misses);
+        os << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    auto align = static_cast<std::size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+int main(int argc, char* argv[])
+{
+    try {
+        Options options = parse_options(argc, argv);
+        Counters counters;
+        bool perf_available = counters.cache_misses.available() || counters.l1d_misses.available();
+        if (!perf_available) {
+            std::cerr << "perf_event_open is not permitted, cache misses are reported as null\n";
+        }
+
+        std::vector<Result> results;
+        std::size_t n = 1;
+        for (int e = 0; e < options.min_exp; ++e) n *= 10;
+
+        for (int e = options.min_exp; e <= options.max_exp; ++e, n *= 10) {
+            std::size_t samples = samples_for(options, n);
+            for (double mix : options.mixes) {
+                std::cerr << "10^" << e << " materials, CNT fraction " << mix << "\n";
+                run<Algorithm>("Algorithm", counters, n, mix, samples, results);
+                run<AlgorithmSBO<32>>("AlgorithmSBO<32>", counters, n, mix, samples, results);
+                run<AlgorithmVtable<24>>("AlgorithmVtable<24>", counters, n, mix, samples, results);
+                run<AlgorithmClosed<BenchCNT, BenchGraphene>>("AlgorithmClosed", counters, n, mix, samples, results);
+            }
+        }
+
+        if (options.out.empty()) {
+            write_json(std::cout, options, perf_available, results);
+        }
+        else {
+            std::ofstream file(options.out);
+            if (!file.is_open()) {
+                throw std::runtime_error("Error opening file: " + options.out);
+            }
+            write_json(file, options, perf_available, results);
+        }
+    }
+    catch (std::exception const& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}
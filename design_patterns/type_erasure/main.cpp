@@ -1,6 +1,14 @@
 #include "materials/materials.H"
+#include "algorithm_impl/material_database.H" // before the algorithm headers
 #include "algorithm_impl/algorithm.H"
+#include "algorithm_impl/algorithm_sbo.H"
+#include "algorithm_impl/algorithm_vtable.H"
+#include "algorithm_impl/material_collection.H"
+#include "algorithm_impl/algorithm_pipeline.H"
+#include "algorithm_impl/algorithm_cow.H"
+#include "algorithm_impl/algorithm_closed.H"
 
+#include <memory_resource>
 #include <vector>
 
 int main() {
@@ -12,4 +20,89 @@ int main() {
     materials.emplace_back( Graphene{2} );
 
     computeAlgorithm(materials);
+
+    // a snapshot whose models all live in one arena, freed at once
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<Algorithm> snapshot(materials.begin(), materials.end(), &arena);
+
+    computeAlgorithm(snapshot);
+
+    // same, but CNT and Graphene are stored inside the vector's elements
+    using MaterialsSBO = std::vector<AlgorithmSBO<32>>;
+
+    MaterialsSBO materials_sbo;
+
+    materials_sbo.emplace_back( CNT{4} );
+    materials_sbo.emplace_back( Graphene{2} );
+
+    computeAlgorithm(materials_sbo);
+
+    // same, but dispatched through a table of function pointers instead of virtual functions
+    using MaterialsVtable = std::vector<AlgorithmVtable<>>;
+
+    MaterialsVtable materials_vtable;
+
+    materials_vtable.emplace_back( CNT{4} );
+    materials_vtable.emplace_back( Graphene{2} );
+
+    computeAlgorithm(materials_vtable);
+
+    // one vector per material type; handles stay valid until removed,
+    // and the CNTs go through the batch affordance in one call
+    MaterialCollection<CNT, Graphene> collection;
+
+    auto cnt = collection.emplace_back( CNT{4} );
+    collection.emplace_back( Graphene{2} );
+    collection.emplace_back( CNT{8} );
+    collection.emplace_back( CNT{6} );
+    collection.remove(cnt);
+
+    computeAlgorithm(collection);
+
+    // three stages per material, each stage run over the whole batch
+    using MaterialsPipeline = std::vector<AlgorithmPipeline<Step1, Step2, Step3>>;
+
+    MaterialsPipeline materials_pipeline;
+
+    materials_pipeline.emplace_back( CNT{4} );
+    materials_pipeline.emplace_back( Graphene{2} );
+
+    computeAlgorithmBatched(materials_pipeline);
+
+    // copies share the materials until one of them is updated
+    MaterialsCOW materials_cow;
+
+    materials_cow.emplace_back( CNT{4} );
+    materials_cow.emplace_back( Graphene{2} );
+
+    MaterialsCOW before_update = materials_cow;
+    updateAlgorithm(materials_cow);
+
+    computeAlgorithm(before_update);
+
+    // the set of materials is known at compile time: a std::variant suffices
+    using MaterialsClosed = std::vector<AlgorithmClosed<CNT, Graphene>>;
+
+    MaterialsClosed materials_closed;
+
+    materials_closed.emplace_back( CNT{4} );
+    materials_closed.emplace_back( Graphene{2} );
+
+    computeAlgorithm(materials_closed);
+
+    // materials stored on disk, used in place through mmap
+    {
+        MaterialDatabaseWriter writer("materials.matdb");
+        writer.append( CNT{4} );
+        writer.append( Graphene{2} );
+    }
+    MaterialDatabase database("materials.matdb");
+
+    computeAlgorithm(database);
+
+    // a record is a material like any other for the type erasure
+    Materials from_database;
+    from_database.emplace_back( database[1] );
+
+    computeAlgorithm(from_database);
 }